@@ -0,0 +1,170 @@
+#ifndef ALIGNEDARENA_HPP
+#define ALIGNEDARENA_HPP
+
+#include <memory_resource>
+#include <cstddef>
+#include <new>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <sys/mman.h> // mmap, madvise (huge pages)
+#endif
+
+#include "AllocationPolicy.hpp"
+
+namespace algebra {
+
+/**
+ * @brief Memory resource handing out 64-byte aligned chunks of one contiguous block.
+ * 
+ * A bump allocator: allocations are carved from the block in order and deallocations only decrease a
+ * counter of live allocations. Once all chunks have been released the block can be reused from the start
+ * (see reserve()), so repeated compress/decompress cycles do not go back to the system allocator.
+ * 
+ * On Linux the block is obtained with mmap, optionally advised for transparent huge pages (madvise) or
+ * backed by explicit huge pages (MAP_HUGETLB), falling back to regular pages when huge pages are not
+ * available. Pages are not touched by the arena: their first touch (hence their NUMA placement) is left
+ * to the code filling the arrays. Requests that do not fit in the block are forwarded to the default resource.
+ */
+class AlignedArena : public std::pmr::memory_resource {
+
+public:
+    /**
+     * @brief Alignment of every chunk (a cache line, also suitable for AVX-512 loads).
+     */
+    static constexpr size_t alignment = 64;
+
+    /**
+     * @brief Creates an empty arena.
+     * 
+     * @param policy Arena policy (decides the kind of pages of the block).
+     */
+    explicit AlignedArena(AllocationPolicy policy) : policy_(policy) {}
+
+    AlignedArena(const AlignedArena&) = delete;
+    AlignedArena& operator=(const AlignedArena&) = delete;
+
+    ~AlignedArena() override { release_block(); }
+
+    /**
+     * @brief Makes the arena ready for `bytes` bytes of allocations.
+     * 
+     * If no chunk is live the arena restarts from the beginning of its block, which is replaced by a
+     * larger one only if it is too small. If chunks are still live nothing is reset.
+     * 
+     * @param bytes Total size (alignment padding included) of the upcoming allocations.
+     */
+    void reserve(size_t bytes) {
+        if (live_ != 0) {
+            return;
+        }
+        offset_ = 0;
+        if (bytes > capacity_) {
+            release_block();
+            map_block(bytes);
+        }
+    }
+
+    /**
+     * @brief Returns the size of a request once padded to the arena alignment.
+     */
+    static constexpr size_t padded(size_t bytes) { return (bytes + alignment - 1) / alignment * alignment; }
+
+    /**
+     * @brief Returns the capacity of the block in bytes.
+     */
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief Returns a description of the pages actually backing the block.
+     */
+    const char* pages() const { return pages_; }
+
+private:
+    AllocationPolicy policy_;       ///< Requested policy.
+    std::byte* block_ = nullptr;    ///< Beginning of the block.
+    size_t capacity_ = 0;           ///< Usable bytes of the block.
+    size_t mapped_ = 0;             ///< Mapped bytes (capacity rounded to the page size).
+    size_t offset_ = 0;             ///< First free byte.
+    size_t live_ = 0;               ///< Number of live chunks carved from the block.
+    const char* pages_ = "none";    ///< Kind of pages backing the block.
+
+    /**
+     * @brief Obtains a new block of at least `bytes` bytes.
+     */
+    void map_block(size_t bytes) {
+#if defined(__linux__)
+        constexpr size_t huge_page = size_t(2) << 20;
+        const bool huge = policy_ != AllocationPolicy::Arena;
+        mapped_ = huge ? (bytes + huge_page - 1) / huge_page * huge_page : (bytes + 4095) / 4096 * 4096;
+
+        void* p = MAP_FAILED;
+        if (policy_ == AllocationPolicy::ArenaExplicitHugePages) {
+            p = mmap(nullptr, mapped_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            pages_ = "explicit huge pages";
+        }
+        if (p == MAP_FAILED) { // regular mapping (also the fallback when no huge page is reserved)
+            p = mmap(nullptr, mapped_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            pages_ = "regular pages";
+            if (p != MAP_FAILED && huge && madvise(p, mapped_, MADV_HUGEPAGE) == 0) {
+                pages_ = "transparent huge pages";
+            }
+        }
+        if (p == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        block_ = static_cast<std::byte*>(p);
+#else
+        mapped_ = padded(bytes);
+        block_ = static_cast<std::byte*>(::operator new(mapped_, std::align_val_t(alignment)));
+        pages_ = "regular pages";
+#endif
+        capacity_ = mapped_;
+    }
+
+    /**
+     * @brief Returns the block to the system.
+     */
+    void release_block() {
+        if (!block_) {
+            return;
+        }
+#if defined(__linux__)
+        munmap(block_, mapped_);
+#else
+        ::operator delete(block_, std::align_val_t(alignment));
+#endif
+        block_ = nullptr;
+        capacity_ = mapped_ = offset_ = 0;
+    }
+
+    void* do_allocate(size_t bytes, size_t align) override {
+        // bump allocation inside the block, default resource otherwise
+        if (align <= alignment && offset_ + padded(bytes) <= capacity_) {
+            void* p = block_ + offset_;
+            offset_ += padded(bytes);
+            ++live_;
+            return p;
+        }
+        return std::pmr::get_default_resource()->allocate(bytes, std::max(align, alignment));
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t align) override {
+        std::byte* b = static_cast<std::byte*>(p);
+        if (block_ && b >= block_ && b < block_ + capacity_) {
+            if (--live_ == 0) {
+                offset_ = 0; // whole block free again
+            }
+            return;
+        }
+        std::pmr::get_default_resource()->deallocate(p, bytes, std::max(align, alignment));
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+} // namespace algebra
+
+#endif // ALIGNEDARENA_HPP
@@ -0,0 +1,39 @@
+#ifndef ALLOCATIONPOLICY_HPP
+#define ALLOCATIONPOLICY_HPP
+
+namespace algebra {
+
+/**
+ * @brief Enumeration of the allocation policies of the compressed arrays.
+ * 
+ * - @ref AllocationPolicy::Default : each array is allocated separately with the default allocator (malloc).
+ * - @ref AllocationPolicy::Arena : outer_ptr, inner_index and values live in one contiguous, 64-byte aligned arena (only values when the index arrays are shared with a frozen pattern).
+ * - @ref AllocationPolicy::ArenaTransparentHugePages : arena advised for transparent huge pages (madvise).
+ * - @ref AllocationPolicy::ArenaExplicitHugePages : arena backed by explicit huge pages (MAP_HUGETLB), with fallback to transparent huge pages.
+ */
+enum class AllocationPolicy {
+    Default,                   ///< Separate default allocations.
+    Arena,                     ///< One aligned arena, regular pages.
+    ArenaTransparentHugePages, ///< One aligned arena, transparent huge pages.
+    ArenaExplicitHugePages     ///< One aligned arena, explicit huge pages (with fallback).
+};
+
+/**
+ * @brief Converts an AllocationPolicy enum value to its corresponding string.
+ * 
+ * @param policy The AllocationPolicy to convert.
+ * @return A C-style string describing the policy.
+ */
+inline const char* allocationPolicyToString(AllocationPolicy policy) {
+    switch (policy) {
+        case AllocationPolicy::Default: return "Default";
+        case AllocationPolicy::Arena: return "Arena";
+        case AllocationPolicy::ArenaTransparentHugePages: return "Arena (transparent huge pages)";
+        case AllocationPolicy::ArenaExplicitHugePages: return "Arena (explicit huge pages)";
+        default: return "Unknown";
+    }
+}
+
+} // namespace algebra
+
+#endif // ALLOCATIONPOLICY_HPP
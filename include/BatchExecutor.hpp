@@ -0,0 +1,182 @@
+#ifndef BATCHEXECUTOR_HPP
+#define BATCHEXECUTOR_HPP
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <queue>
+#include <stdexcept>
+#include <cmath>
+
+#include "Matrix.hpp"
+
+namespace algebra {
+
+/**
+ * @brief One matrix-vector product of a batch: y = matrix * x.
+ *
+ * @tparam T Type of the matrix elements.
+ * @tparam Order Storage order of the matrix.
+ *
+ * The executor does not own the operands: they must stay alive until the batch has been run.
+ * y is resized to the number of rows of the matrix (its capacity is reused across batches); it must not be x.
+ */
+template<typename T, StorageOrder Order>
+struct SpMVJob {
+    const Matrix<T, Order>* matrix; ///< Matrix (compressed or not).
+    const std::vector<T>* x;        ///< Input vector (size = columns of the matrix).
+    std::vector<T>* y;              ///< Output vector.
+};
+
+/**
+ * @brief Throughput and latency figures of one batch.
+ *
+ * The latency of a job is the time from the submission of the batch to the completion of the job.
+ */
+struct BatchStats {
+    size_t n_jobs = 0;           ///< Number of jobs.
+    size_t n_large_jobs = 0;     ///< Jobs run with intra-matrix parallelism.
+    size_t n_steals = 0;         ///< Jobs taken from the queue of another worker.
+    size_t nnz = 0;              ///< Total number of stored entries multiplied.
+    double elapsed_ms = 0;       ///< Wall time of the whole batch.
+    double jobs_per_second = 0;  ///< Throughput.
+    double p50_latency_ms = 0;   ///< Median latency.
+    double p99_latency_ms = 0;   ///< 99th percentile latency.
+    double max_latency_ms = 0;   ///< Maximum latency.
+};
+
+/**
+ * @brief Runs batches of independent matrix-vector products on a work-stealing thread pool.
+ *
+ * @tparam T Type of the matrix elements.
+ * @tparam Order Storage order of the matrices.
+ *
+ * Small matrices (below the OpenMP thresholds of product_by_vector()) are multiplied serially, so a loop of
+ * products leaves most cores idle. The executor splits a batch in two classes:
+ * - large jobs (at least `large_job_nnz` stored entries) are run one at a time with the OpenMP parallel
+ *   product (intra-matrix parallelism);
+ * - small jobs are packed by nnz over the per-worker queues (longest job first, each to the least loaded queue)
+ *   and multiplied serially by the workers (inter-matrix parallelism). A worker that empties its queue steals
+ *   jobs from the others.
+ *
+ * The worker threads are created once and wait for the next batch between runs.
+ */
+template<typename T, StorageOrder Order>
+class BatchExecutor {
+
+public:
+    using Job = SpMVJob<T, Order>;
+
+private:
+    /**
+     * @brief Job queue of one worker (cache-line aligned to avoid false sharing between workers).
+     */
+    struct alignas(64) WorkQueue {
+        std::mutex mutex;        ///< Protects jobs.
+        std::deque<size_t> jobs; ///< Indices of the jobs, largest first.
+    };
+
+    size_t large_job_nnz_; ///< Threshold between small and large jobs.
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_; ///< One queue per worker.
+    std::vector<std::thread> workers_;               ///< Worker threads.
+
+    // Synchronisation with the workers
+    std::mutex mutex_;                  ///< Protects generation_, stop_ and active_workers_.
+    std::condition_variable start_cv_;  ///< Signals a new batch (or the shutdown) to the workers.
+    std::condition_variable done_cv_;   ///< Signals the end of the batch to run().
+    size_t generation_ = 0;             ///< Number of batches submitted to the workers.
+    size_t active_workers_ = 0;         ///< Workers still processing the current batch.
+    bool stop_ = false;                 ///< Set by the destructor.
+
+    // Current batch
+    const std::vector<Job>* jobs_ = nullptr;            ///< Jobs of the batch being run.
+    std::vector<double> latency_;                       ///< Latency of each job (ms).
+    std::chrono::steady_clock::time_point batch_start_; ///< Submission time of the batch.
+    std::atomic<size_t> steals_{0};                     ///< Steals during the batch.
+
+    // 🔒 PRIVATE METHODS
+
+    /**
+     * @brief Main loop of a worker: waits for a batch, then processes jobs until no queue has any left.
+     *
+     * @param id Index of the worker (and of its queue).
+     */
+    void worker_loop(size_t id);
+
+    /**
+     * @brief Takes the next job for a worker: the largest of its own queue, otherwise the smallest of another queue.
+     *
+     * @param id Index of the worker.
+     * @param job Output: index of the job.
+     * @return False if all queues are empty.
+     */
+    bool pop(size_t id, size_t& job);
+
+    /**
+     * @brief Multiplies a small job serially, writing directly into y (Matrix::product_by_vector(x, y)).
+     */
+    static void execute(const Job& job);
+
+    /**
+     * @brief Records the latency of a job (time elapsed since the submission of the batch).
+     */
+    void record(size_t job);
+
+public:
+    // 🏗️ CONSTRUCTORS
+
+    /**
+     * @brief Starts the worker threads.
+     *
+     * @param n_workers Number of worker threads (at least one).
+     * @param large_job_nnz Jobs with at least this many stored entries use intra-matrix parallelism.
+     */
+    explicit BatchExecutor(size_t n_workers = std::max(1u, std::thread::hardware_concurrency()),
+                           size_t large_job_nnz = params::BATCH_LARGE_JOB_NNZ);
+
+    BatchExecutor(const BatchExecutor&) = delete;
+    BatchExecutor& operator=(const BatchExecutor&) = delete;
+
+    /**
+     * @brief Stops and joins the worker threads.
+     */
+    ~BatchExecutor();
+
+    // 🔥 CORE METHODS
+
+    /**
+     * @brief Runs a batch of products and returns when all of them are done.
+     *
+     * Small jobs are run first on the pool, then large jobs one by one with the OpenMP parallel product.
+     *
+     * @param jobs Jobs of the batch.
+     * @return Throughput and latency of the batch.
+     * @throws std::invalid_argument if a job has a null operand, x does not match the columns of the matrix, or y is x.
+     */
+    BatchStats run(const std::vector<Job>& jobs);
+
+    // ℹ️ INFO
+
+    /**
+     * @brief Returns the number of worker threads.
+     */
+    size_t n_workers() const { return workers_.size(); }
+
+    /**
+     * @brief Returns the threshold between small and large jobs.
+     */
+    size_t large_job_nnz() const { return large_job_nnz_; }
+};
+
+} // namespace algebra
+
+#include "BatchExecutor.tpp" // methods implementation
+
+#endif // BATCHEXECUTOR_HPP
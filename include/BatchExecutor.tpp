@@ -0,0 +1,196 @@
+/* This .tpp file contains the implementation of the BatchExecutor class template.
+It defines the worker threads with their work-stealing queues, the packing of small jobs by nnz,
+the in-place serial product and the throughput/latency statistics of a batch.
+ */
+#include "BatchExecutor.hpp"
+
+namespace algebra{
+
+// 🏗️ CONSTRUCTORS
+template<typename T, StorageOrder Order>
+BatchExecutor<T, Order>::BatchExecutor(size_t n_workers, size_t large_job_nnz) : large_job_nnz_(large_job_nnz) {
+// Creates one queue per worker and starts the workers, which wait for the first batch.
+
+    n_workers = std::max<size_t>(n_workers, 1);
+    for (size_t w = 0; w < n_workers; ++w) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+    for (size_t w = 0; w < n_workers; ++w) {
+        workers_.emplace_back(&BatchExecutor::worker_loop, this, w);
+    }
+}
+
+template<typename T, StorageOrder Order>
+BatchExecutor<T, Order>::~BatchExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+// 🔒 PRIVATE METHODS
+template<typename T, StorageOrder Order>
+void BatchExecutor<T, Order>::worker_loop(size_t id) {
+// Waits for a new batch, drains the queues (own first, then stealing), and reports the end of its work.
+// Queues are filled before a batch is started and only shrink, so an unsuccessful pop means the worker is done.
+
+    size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+        }
+
+        size_t job;
+        while (pop(id, job)) {
+            execute((*jobs_)[job]);
+            record(job);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--active_workers_ == 0) {
+            done_cv_.notify_one();
+        }
+    }
+}
+
+template<typename T, StorageOrder Order>
+bool BatchExecutor<T, Order>::pop(size_t id, size_t& job) {
+// The owner takes the largest job left in its own queue (front); thieves take the smallest job (back)
+// of the other queues, visited in round-robin order starting from the next worker.
+
+    {
+        WorkQueue& own = *queues_[id];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.front();
+            own.jobs.pop_front();
+            return true;
+        }
+    }
+
+    const size_t n = queues_.size();
+    for (size_t k = 1; k < n; ++k) {
+        WorkQueue& victim = *queues_[(id + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.back();
+            victim.jobs.pop_back();
+            steals_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename T, StorageOrder Order>
+void BatchExecutor<T, Order>::execute(const Job& job) {
+// Serial product written directly into y, so that no output vector is allocated per job.
+    job.matrix->product_by_vector(*job.x, *job.y);
+}
+
+template<typename T, StorageOrder Order>
+void BatchExecutor<T, Order>::record(size_t job) {
+    latency_[job] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - batch_start_).count();
+}
+
+// 🔥 CORE METHODS
+template<typename T, StorageOrder Order>
+BatchStats BatchExecutor<T, Order>::run(const std::vector<Job>& jobs) {
+// 1. Checks the jobs and splits them into small and large ones.
+// 2. Packs the small jobs over the worker queues (longest processing time first) and runs them on the pool.
+// 3. Runs the large jobs one at a time with the OpenMP parallel product.
+// 4. Computes throughput and latency percentiles.
+
+    BatchStats stats;
+    stats.n_jobs = jobs.size();
+
+    std::vector<size_t> job_nnz(jobs.size());
+    std::vector<size_t> small, large;
+    for (size_t k = 0; k < jobs.size(); ++k) {
+        const Job& job = jobs[k];
+        if (!job.matrix || !job.x || !job.y) {
+            throw std::invalid_argument("Batch job with a null operand.");
+        }
+        if (job.x->size() != job.matrix->size()[1]) {
+            throw std::invalid_argument("Batch job: vector size does not match the matrix columns.");
+        }
+        if (job.x == job.y) {
+            throw std::invalid_argument("Batch job: y must be distinct from x.");
+        }
+        job_nnz[k] = job.matrix->nnz();
+        stats.nnz += job_nnz[k];
+        (job_nnz[k] >= large_job_nnz_ ? large : small).push_back(k);
+    }
+    stats.n_large_jobs = large.size();
+
+    jobs_ = &jobs;
+    latency_.assign(jobs.size(), 0.0);
+    steals_.store(0, std::memory_order_relaxed);
+    batch_start_ = std::chrono::steady_clock::now();
+
+    // 2. Small jobs: largest first, each to the least loaded queue (min-heap of (load, queue))
+    if (!small.empty()) {
+        std::stable_sort(small.begin(), small.end(), [&](size_t a, size_t b) { return job_nnz[a] > job_nnz[b]; });
+
+        using Load = std::pair<size_t, size_t>;
+        std::priority_queue<Load, std::vector<Load>, std::greater<Load>> loads;
+        for (size_t w = 0; w < queues_.size(); ++w) {
+            loads.push({0, w});
+        }
+        for (size_t k : small) {
+            auto [load, w] = loads.top();
+            loads.pop();
+            queues_[w]->jobs.push_back(k); // workers are idle: no lock needed before the batch starts
+            loads.push({load + job_nnz[k] + jobs[k].matrix->size()[0], w}); // rows account for the output writes
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            active_workers_ = workers_.size();
+            ++generation_;
+        }
+        start_cv_.notify_all();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [&] { return active_workers_ == 0; });
+    }
+
+    // 3. Large jobs: intra-matrix parallelism
+    for (size_t k : large) {
+        const Job& job = jobs[k];
+        *job.y = job.matrix->is_compressed() ? job.matrix->compressed_product_by_vector_parallel(*job.x)
+                                             : job.matrix->product_by_vector(*job.x);
+        record(k);
+    }
+
+    // 4. Statistics
+    stats.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - batch_start_).count();
+    stats.n_steals = steals_.load(std::memory_order_relaxed);
+    jobs_ = nullptr;
+
+    if (!jobs.empty()) {
+        std::vector<double> sorted = latency_;
+        std::sort(sorted.begin(), sorted.end());
+        auto percentile = [&](double p) {
+            size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+            return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+        };
+        stats.jobs_per_second = stats.n_jobs / (stats.elapsed_ms / 1000.0);
+        stats.p50_latency_ms = percentile(0.50);
+        stats.p99_latency_ms = percentile(0.99);
+        stats.max_latency_ms = sorted.back();
+    }
+
+    return stats;
+}
+
+} // namespace algebra
@@ -1,6 +1,16 @@
 #ifndef COMPRESSEDMATRIX_HPP
 #define COMPRESSEDMATRIX_HPP
 
+#include <memory>
+#include <memory_resource>
+#include <vector>
+#include <cstring>
+
+#include "AlignedArena.hpp"
+#include "IndexArray.hpp"
+#include "StorageOrder.hpp"
+#include "Parameters.hpp"
+
 namespace algebra{
 
 /**
@@ -12,31 +22,186 @@ namespace algebra{
  * compressed sparse column (CSC) representation: the nonzero values, the 
  * inner indices (column indices in CSR or row indices in CSC), and the 
  * outer pointers (row pointers in CSR or column pointers in CSC).
+ * 
+ * The three arrays use polymorphic allocators: with the Default policy they use the
+ * default allocator, with an arena policy they are carved from one 64-byte aligned AlignedArena
+ * owned by the structure, which is reused across recompressions. The two index arrays can instead
+ * be shared views on the arrays of a frozen SparsityPattern (see share_indices()); they are then
+ * read-only and detached into owned storage by the first write.
  */
 template<typename T>
 struct CompressedMatrix {
+    /**
+     * @brief Allocation policy of the three arrays.
+     */
+    AllocationPolicy policy = AllocationPolicy::Default;
+
+    /**
+     * @brief Storage order of the owning matrix (selects the parallel threshold of the first touch, as product_by_vector() does).
+     */
+    StorageOrder order = StorageOrder::RowMajor;
+
+    /**
+     * @brief Arena holding the three arrays (null with the Default policy). Declared before the arrays, so it outlives them.
+     */
+    std::unique_ptr<AlignedArena> arena;
+
     /**
      * @brief Vector containing the nonzero values of the matrix.
      */
-    std::vector<T> values;        
+    std::pmr::vector<T> values;        
 
     /**
      * @brief Vector containing the column indices (in CSR) or row indices (in CSC) for each nonzero value.
      */
-    std::vector<size_t> inner_index;
+    IndexArray inner_index;
 
     /**
      * @brief Vector containing the starting positions of each row (in CSR) or column (in CSC) in the values array.
      */
-    std::vector<size_t> outer_ptr;
+    IndexArray outer_ptr;
+
+    /**
+     * @brief Constructs an empty structure with the Default policy.
+     */
+    CompressedMatrix() = default;
+
+    /**
+     * @brief Constructs an empty structure with the Default policy, for a matrix with the given storage order.
+     */
+    explicit CompressedMatrix(StorageOrder storage_order) : order(storage_order) {}
+
+    /**
+     * @brief Copies the arrays into storage allocated with the same policy (the arena is never shared,
+     * shared index arrays stay shared).
+     */
+    CompressedMatrix(const CompressedMatrix& other) : order(other.order) {
+        set_policy(other.policy);
+        copy_from(other);
+    }
+
+    /**
+     * @brief Takes over the arrays and the arena; other is left empty with the Default policy.
+     */
+    CompressedMatrix(CompressedMatrix&& other) noexcept
+        : policy(other.policy), order(other.order), arena(std::move(other.arena)),
+          values(std::move(other.values)), inner_index(std::move(other.inner_index)), outer_ptr(std::move(other.outer_ptr)) {
+        other.policy = AllocationPolicy::Default;
+        other.rebind(std::pmr::get_default_resource());
+    }
+
+    /**
+     * @brief Copy assignment (see the copy constructor).
+     */
+    CompressedMatrix& operator=(const CompressedMatrix& other) {
+        if (this != &other) {
+            *this = CompressedMatrix(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment (see the move constructor).
+     * 
+     * Vectors with different memory resources cannot exchange their buffers, so the object is rebuilt in place.
+     */
+    CompressedMatrix& operator=(CompressedMatrix&& other) noexcept {
+        if (this != &other) {
+            std::destroy_at(this);
+            std::construct_at(this, std::move(other));
+        }
+        return *this;
+    }
 
     /**
-     * @brief Clears all vectors and deallocates their memory.
+     * @brief Returns the memory resource used by the three arrays.
+     */
+    std::pmr::memory_resource* resource() const {
+        return arena ? static_cast<std::pmr::memory_resource*>(arena.get()) : std::pmr::get_default_resource();
+    }
+
+    /**
+     * @brief Changes the allocation policy, moving the current content into the new storage.
+     * 
+     * Shared index arrays stay shared: only the values move.
+     * 
+     * @param new_policy Policy to adopt.
+     */
+    void set_policy(AllocationPolicy new_policy) {
+        std::vector<T> old_values(values.begin(), values.end());
+        auto shared_outer = outer_ptr.shared();
+        auto shared_inner = inner_index.shared();
+        std::vector<size_t> old_inner, old_outer;
+        if (!shared_outer) {
+            old_outer.assign(outer_ptr.begin(), outer_ptr.end());
+        }
+        if (!shared_inner) {
+            old_inner.assign(inner_index.begin(), inner_index.end());
+        }
+
+        rebind(std::pmr::get_default_resource()); // release the old storage before dropping the arena
+        policy = new_policy;
+        arena = (policy == AllocationPolicy::Default) ? nullptr : std::make_unique<AlignedArena>(policy);
+        rebind(resource());
+
+        if (shared_outer && shared_inner) {
+            share_indices(std::move(shared_outer), std::move(shared_inner));
+        } else if (!old_outer.empty()) {
+            reserve(old_outer);
+            outer_ptr.assign(old_outer.begin(), old_outer.end());
+            if (shared_inner) {
+                inner_index.share(std::move(shared_inner));
+            } else {
+                inner_index.assign(old_inner.begin(), old_inner.end());
+            }
+        }
+        values.assign(old_values.begin(), old_values.end());
+    }
+
+    /**
+     * @brief Prepares the storage for a matrix with the given outer pointers (the arrays are emptied).
+     * 
+     * With an arena policy, the arena is reset (or grown) to hold the three arrays, their capacity is reserved,
+     * and the pages of inner_index and values are first touched with the same static OpenMP schedule over the outer
+     * dimension used by the parallel product, so that each page is placed near the thread reading it. As in
+     * product_by_vector(), the first touch is parallel only above the row (CSR) or column (CSC) threshold.
+     * With the Default policy this only empties the arrays.
+     * 
+     * @tparam PtrVector Vector type of the outer pointers.
+     * @param ptr Outer pointers of the matrix that will be stored (ptr.back() is the number of nonzeros).
+     */
+    template<typename PtrVector>
+    void reserve(const PtrVector& ptr) {
+        clear();
+        prepare(ptr, true);
+    }
+
+    /**
+     * @brief Makes the index arrays views on shared storage and sets all values to zero.
+     * 
+     * Only the values are allocated (and, with an arena policy, first touched as in reserve()).
+     * 
+     * @param shared_outer Shared outer pointers.
+     * @param shared_inner Shared inner indices.
+     */
+    void share_indices(std::shared_ptr<const std::vector<size_t>> shared_outer, std::shared_ptr<const std::vector<size_t>> shared_inner) {
+        clear();
+        prepare(*shared_outer, false);
+        outer_ptr.share(std::move(shared_outer));
+        inner_index.share(std::move(shared_inner));
+        values.assign(inner_index.size(), T(0));
+    }
+
+    /**
+     * @brief Clears all vectors and deallocates their memory (an arena keeps its block for reuse).
      */
     void clear() { 
-        std::vector<T>().swap(values);
-        std::vector<size_t>().swap(inner_index);
-        std::vector<size_t>().swap(outer_ptr);
+        values.clear();
+        values.shrink_to_fit();
+        inner_index.clear();
+        inner_index.shrink_to_fit();
+        outer_ptr.clear();
+        outer_ptr.shrink_to_fit();
     }
 
     /**
@@ -68,6 +233,77 @@ struct CompressedMatrix {
             return T(0); // If not found, it's zero
         }
     }
+
+private:
+    /**
+     * @brief Reserves the arena and the arrays for the given outer pointers and first touches them (see reserve()).
+     * 
+     * @param ptr Outer pointers of the matrix that will be stored.
+     * @param with_indices Whether the index arrays are allocated too (false when they are shared).
+     */
+    template<typename PtrVector>
+    void prepare(const PtrVector& ptr, bool with_indices) {
+        if (!arena || ptr.empty()) {
+            return;
+        }
+
+        const size_t outer_size = ptr.size() - 1;
+        const size_t nnz = ptr.back();
+        arena->reserve((with_indices ? AlignedArena::padded((outer_size + 1) * sizeof(size_t))
+                                     + AlignedArena::padded(nnz * sizeof(size_t)) : 0)
+                     + AlignedArena::padded(nnz * sizeof(T)));
+        if (with_indices) {
+            outer_ptr.reserve(outer_size + 1);
+            inner_index.reserve(nnz);
+        }
+        values.reserve(nnz);
+
+        // First touch of the (still unconstructed) storage, same schedule as compressed_product_by_vector_parallel
+        std::byte* inner_bytes = with_indices ? reinterpret_cast<std::byte*>(inner_index.mutable_data()) : nullptr;
+        std::byte* value_bytes = reinterpret_cast<std::byte*>(values.data());
+        const size_t limit = (order == StorageOrder::RowMajor) ? params::NROWS_PARALLELIZATON_LIMIT : params::NCOLS_PARALLELIZATON_LIMIT;
+        #pragma omp parallel for schedule(static) if(outer_size >= limit)
+        for (size_t outer = 0; outer < outer_size; ++outer) {
+            const size_t count = ptr[outer + 1] - ptr[outer];
+            if (count == 0) continue;
+            if (inner_bytes) {
+                std::memset(inner_bytes + ptr[outer] * sizeof(size_t), 0, count * sizeof(size_t));
+            }
+            std::memset(value_bytes + ptr[outer] * sizeof(T), 0, count * sizeof(T));
+        }
+    }
+
+    /**
+     * @brief Replaces the three arrays with empty ones using the given memory resource.
+     * 
+     * The allocator of a polymorphic vector cannot be changed by assignment, so the vectors are rebuilt in place.
+     */
+    void rebind(std::pmr::memory_resource* res) {
+        std::destroy_at(&values);
+        std::destroy_at(&inner_index);
+        std::destroy_at(&outer_ptr);
+        std::construct_at(&values, res);
+        std::construct_at(&inner_index, res);
+        std::construct_at(&outer_ptr, res);
+    }
+
+    /**
+     * @brief Copies the arrays of another structure into the current storage.
+     */
+    void copy_from(const CompressedMatrix& other) {
+        if (other.outer_ptr.empty()) {
+            return;
+        }
+        if (other.outer_ptr.shared() && other.inner_index.shared()) {
+            share_indices(other.outer_ptr.shared(), other.inner_index.shared());
+            values.assign(other.values.begin(), other.values.end());
+            return;
+        }
+        reserve(other.outer_ptr);
+        outer_ptr.assign(other.outer_ptr.begin(), other.outer_ptr.end());
+        inner_index.assign(other.inner_index.begin(), other.inner_index.end());
+        values.assign(other.values.begin(), other.values.end());
+    }
 };
 
 } // namespace algebra
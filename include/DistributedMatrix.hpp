@@ -0,0 +1,233 @@
+#ifndef DISTRIBUTEDMATRIX_HPP
+#define DISTRIBUTEDMATRIX_HPP
+
+// STL Headers
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <type_traits>
+#include <climits>
+#include <stdexcept>
+
+// External libraries
+#include <mpi.h> // for distributed-memory parallelism (build with mpicxx, see `make mpi`)
+
+// Project headers
+#include "Matrix.hpp"
+
+namespace algebra {
+
+/**
+ * @brief A sparse matrix distributed by rows across the ranks of an MPI communicator.
+ *
+ * @tparam T Type of the matrix elements (must be trivially copyable, it is sent as a contiguous block of bytes).
+ *
+ * Rows and columns are split in contiguous blocks, one per rank; vectors are distributed with the same
+ * column/row blocks. The local rows of each rank are stored as two compressed Matrix<T, RowMajor> blocks:
+ * - the diagonal block, holding the columns owned by the rank (local column numbering);
+ * - the off-diagonal block, holding the other columns, renumbered compactly as "ghost" columns.
+ *
+ * A halo-exchange plan (which ghost values to receive from which rank, which local values to send to
+ * which rank) is precomputed once. The distributed matrix-vector product posts the non-blocking halo
+ * exchange, multiplies the diagonal block while the messages are in flight, then adds the off-diagonal
+ * contribution.
+ */
+template<typename T>
+class DistributedMatrix {
+
+    static_assert(std::is_trivially_copyable_v<T>, "DistributedMatrix sends elements as raw bytes");
+
+private:
+    /**
+     * @brief A matrix entry with global indices, as exchanged between ranks.
+     */
+    struct Entry {
+        size_t i; ///< Global row index.
+        size_t j; ///< Global column index.
+        T value;  ///< Value.
+    };
+
+    // 📦 DATA
+
+    MPI_Comm comm_; ///< Communicator.
+    int rank_;      ///< Rank of this process.
+    int n_ranks_;   ///< Number of ranks.
+
+    size_t rows_; ///< Global number of rows.
+    size_t cols_; ///< Global number of columns.
+
+    std::vector<size_t> row_partition_; ///< Rows of rank r are [row_partition_[r], row_partition_[r+1]).
+    std::vector<size_t> col_partition_; ///< Columns (and vector entries) of rank r are [col_partition_[r], col_partition_[r+1]).
+
+    Matrix<T, StorageOrder::RowMajor> diag_block_;    ///< Local rows x owned columns.
+    Matrix<T, StorageOrder::RowMajor> offdiag_block_; ///< Local rows x ghost columns.
+    std::vector<size_t> ghost_cols_;                  ///< Global index of each ghost column (sorted).
+
+    // Halo-exchange plan
+    std::vector<int> recv_ranks_;     ///< Ranks we receive ghost values from.
+    std::vector<size_t> recv_ptr_;    ///< Ghost values from recv_ranks_[n] are ghost_buffer_[recv_ptr_[n] .. recv_ptr_[n+1]).
+    std::vector<int> send_ranks_;     ///< Ranks we send owned values to.
+    std::vector<size_t> send_ptr_;    ///< Values for send_ranks_[n] are send_index_[send_ptr_[n] .. send_ptr_[n+1]).
+    std::vector<size_t> send_index_;  ///< Local indices of the owned values to send.
+
+    mutable std::vector<T> send_buffer_;  ///< Packed values to send.
+    mutable std::vector<T> ghost_buffer_; ///< Received ghost values.
+
+    // 🔒 PRIVATE METHODS
+
+    /**
+     * @brief Returns a committed MPI datatype made of sizeof(U) contiguous bytes.
+     *
+     * Messages are described with this type, so that MPI counts are numbers of elements instead of bytes
+     * (a byte count overflows int at 2 GiB, i.e. about 89M entries of Entry<double>). The type is created
+     * on the first call and released by MPI_Finalize.
+     *
+     * @tparam U Type of the elements (Entry or T).
+     */
+    template<typename U>
+    static MPI_Datatype contiguous_type();
+
+    /**
+     * @brief Converts an element count or displacement to the int expected by MPI.
+     *
+     * @throws std::overflow_error if n does not fit in an int.
+     */
+    static int to_count(size_t n);
+
+    /**
+     * @brief Splits n items into contiguous blocks of (almost) equal size, one per rank.
+     *
+     * @return Block boundaries (size n_ranks_ + 1).
+     */
+    std::vector<size_t> block_partition(size_t n) const;
+
+    /**
+     * @brief Returns the rank owning a global index according to a partition.
+     */
+    static int owner(const std::vector<size_t>& partition, size_t index);
+
+    /**
+     * @brief Sends every entry to the rank owning its row.
+     *
+     * @param entries Entries read by this rank (any row).
+     * @return Entries whose row is owned by this rank.
+     */
+    std::vector<Entry> redistribute(const std::vector<Entry>& entries) const;
+
+    /**
+     * @brief Builds the diagonal/off-diagonal blocks and the halo-exchange plan from the local entries.
+     *
+     * @param entries Entries whose row is owned by this rank (global indices).
+     */
+    void build(const std::vector<Entry>& entries);
+
+    /**
+     * @brief Parses Matrix Market triplets from a text chunk (1-based indices), skipping comments.
+     */
+    static void parse_entries(const std::string& chunk, std::vector<Entry>& entries);
+
+public:
+    // 🏗️ CONSTRUCTORS
+
+    /**
+     * @brief Constructs an empty distributed matrix, to be filled with mm_load_mtx().
+     *
+     * @param comm Communicator.
+     */
+    explicit DistributedMatrix(MPI_Comm comm = MPI_COMM_WORLD);
+
+    /**
+     * @brief Distributes a matrix held by the root rank.
+     *
+     * The root sends to every rank the entries of its rows; on the other ranks `global` is ignored.
+     *
+     * @param global Matrix to distribute (meaningful on the root only, compressed or not).
+     * @param comm Communicator.
+     * @param root Rank holding the matrix.
+     */
+    DistributedMatrix(const Matrix<T, StorageOrder::RowMajor>& global, MPI_Comm comm = MPI_COMM_WORLD, int root = 0);
+
+    // 🔥 CORE METHODS
+
+    /**
+     * @brief Distributed matrix-vector product.
+     *
+     * Posts the non-blocking halo exchange, multiplies the diagonal block while it is in progress,
+     * waits for the ghost values and adds the off-diagonal block contribution.
+     *
+     * @param x Local part of the input vector (columns owned by this rank).
+     * @return Local part of the result (rows owned by this rank).
+     */
+    std::vector<T> product_by_vector(const std::vector<T>& x) const;
+
+    /**
+     * @brief Splits a vector held by the root into the local parts of all ranks (column partition).
+     *
+     * @param global Vector of size cols (meaningful on the root only).
+     * @param root Rank holding the vector.
+     * @return Local part of the vector.
+     */
+    std::vector<T> scatter(const std::vector<T>& global, int root = 0) const;
+
+    /**
+     * @brief Collects the local parts of a row-distributed vector on the root.
+     *
+     * @param local Local part (rows owned by this rank).
+     * @param root Rank receiving the vector.
+     * @return The full vector on the root, an empty vector elsewhere.
+     */
+    std::vector<T> gather(const std::vector<T>& local, int root = 0) const;
+
+    // MATRIX MARKET PARALLEL LOADER
+
+    /**
+     * @brief Loads a Matrix Market file in parallel.
+     *
+     * For .mtx files each rank reads only its own byte range of the file (aligned to whole lines) and the
+     * triplets are then sent to the rank owning their row. For .mtx.gz files, which cannot be read from
+     * an arbitrary offset, each rank inflates the file and keeps the triplets of its own rows.
+     *
+     * @param filename Path to the file.
+     * @return True if loading was successful on all ranks, false otherwise.
+     */
+    bool mm_load_mtx(const std::string& filename);
+
+    // ℹ️ INFO & PRINTING METHODS
+
+    /**
+     * @brief Returns the global dimensions of the matrix.
+     */
+    std::array<size_t, 2> size() const { return {rows_, cols_}; }
+
+    /**
+     * @brief Returns the first global row owned by this rank.
+     */
+    size_t row_begin() const { return row_partition_[rank_]; }
+
+    /**
+     * @brief Returns the number of rows owned by this rank.
+     */
+    size_t local_rows() const { return row_partition_[rank_ + 1] - row_partition_[rank_]; }
+
+    /**
+     * @brief Returns the number of columns (vector entries) owned by this rank.
+     */
+    size_t local_cols() const { return col_partition_[rank_ + 1] - col_partition_[rank_]; }
+
+    /**
+     * @brief Returns the number of ghost columns of this rank.
+     */
+    size_t n_ghosts() const { return ghost_cols_.size(); }
+
+    /**
+     * @brief Prints, rank by rank, the local rows, block sizes, ghosts and neighbours.
+     */
+    void info() const;
+};
+
+} // namespace algebra
+
+#include "DistributedMatrix.tpp" // methods implementation
+
+#endif // DISTRIBUTEDMATRIX_HPP
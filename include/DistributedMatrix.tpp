@@ -0,0 +1,483 @@
+/* This .tpp file contains the implementation of the DistributedMatrix class template.
+It defines the row partitioning, the diagonal/off-diagonal block split with compressed ghost numbering,
+the halo-exchange plan, the overlapped distributed matrix-vector product and the parallel Matrix Market loader.
+ */
+#include "DistributedMatrix.hpp"
+
+namespace algebra{
+
+// 🏗️ CONSTRUCTORS
+template<typename T>
+DistributedMatrix<T>::DistributedMatrix(MPI_Comm comm)
+    : comm_(comm), rows_(0), cols_(0), diag_block_(0, 0), offdiag_block_(0, 0) {
+    MPI_Comm_rank(comm_, &rank_);
+    MPI_Comm_size(comm_, &n_ranks_);
+    row_partition_ = block_partition(0);
+    col_partition_ = block_partition(0);
+}
+
+template<typename T>
+DistributedMatrix<T>::DistributedMatrix(const Matrix<T, StorageOrder::RowMajor>& global, MPI_Comm comm, int root)
+    : DistributedMatrix(comm) {
+// The root collects the entries of the matrix (from CSR or COO storage), sorts them by owner rank
+// and sends to each rank the entries of its rows.
+
+    std::array<unsigned long long, 2> dims = {global.rows_, global.cols_};
+    MPI_Bcast(dims.data(), 2, MPI_UNSIGNED_LONG_LONG, root, comm_);
+    rows_ = dims[0];
+    cols_ = dims[1];
+    row_partition_ = block_partition(rows_);
+    col_partition_ = block_partition(cols_);
+
+    std::vector<Entry> entries;
+    std::vector<int> send_counts(n_ranks_, 0), send_displs(n_ranks_, 0);
+    if (rank_ == root) {
+        // Entries in row order: CSR and the COO map are both sorted by row, so they are already grouped by owner
+        entries.reserve(global.nnz());
+        if (global.is_compressed()) {
+            const auto& data = global.compressed_data_;
+            for (size_t i = 0; i < rows_; ++i) {
+                for (size_t k = data.outer_ptr[i]; k < data.outer_ptr[i + 1]; ++k) {
+                    entries.push_back({i, data.inner_index[k], data.values[k]});
+                }
+            }
+        } else {
+            for (const auto& [key, val] : global.sparse_data_) {
+                entries.push_back({key[0], key[1], val});
+            }
+        }
+        std::vector<size_t> counts(n_ranks_, 0);
+        for (const auto& e : entries) {
+            counts[owner(row_partition_, e.i)]++;
+        }
+        size_t displ = 0;
+        for (int r = 0; r < n_ranks_; ++r) {
+            send_counts[r] = to_count(counts[r]);
+            send_displs[r] = to_count(displ);
+            displ += counts[r];
+        }
+    }
+
+    // Counts and displacements are numbers of entries (see contiguous_type())
+    int recv_count = 0;
+    MPI_Scatter(send_counts.data(), 1, MPI_INT, &recv_count, 1, MPI_INT, root, comm_);
+    std::vector<Entry> local(recv_count);
+    MPI_Scatterv(entries.data(), send_counts.data(), send_displs.data(), contiguous_type<Entry>(),
+                 local.data(), recv_count, contiguous_type<Entry>(), root, comm_);
+
+    build(local);
+}
+
+// 🔒 PRIVATE METHODS
+template<typename T>
+template<typename U>
+MPI_Datatype DistributedMatrix<T>::contiguous_type() {
+// Created and committed once per element type (thread-safe static initialisation).
+
+    static const MPI_Datatype type = [] {
+        MPI_Datatype t;
+        MPI_Type_contiguous(sizeof(U), MPI_BYTE, &t);
+        MPI_Type_commit(&t);
+        return t;
+    }();
+    return type;
+}
+
+template<typename T>
+int DistributedMatrix<T>::to_count(size_t n) {
+    if (n > static_cast<size_t>(INT_MAX)) {
+        throw std::overflow_error("MPI message count exceeds the int range.");
+    }
+    return static_cast<int>(n);
+}
+
+template<typename T>
+std::vector<size_t> DistributedMatrix<T>::block_partition(size_t n) const {
+// Contiguous blocks: the first n % n_ranks_ ranks get one extra item.
+
+    std::vector<size_t> partition(n_ranks_ + 1, 0);
+    for (int r = 0; r < n_ranks_; ++r) {
+        partition[r + 1] = partition[r] + n / n_ranks_ + (size_t(r) < n % n_ranks_ ? 1 : 0);
+    }
+    return partition;
+}
+
+template<typename T>
+int DistributedMatrix<T>::owner(const std::vector<size_t>& partition, size_t index) {
+// Last block whose beginning is <= index.
+    return int(std::upper_bound(partition.begin(), partition.end(), index) - partition.begin()) - 1;
+}
+
+template<typename T>
+std::vector<typename DistributedMatrix<T>::Entry> DistributedMatrix<T>::redistribute(const std::vector<Entry>& entries) const {
+// All-to-all exchange of the entries, each one going to the rank that owns its row.
+
+    std::vector<int> send_counts(n_ranks_, 0), send_displs(n_ranks_, 0);
+    std::vector<int> recv_counts(n_ranks_, 0), recv_displs(n_ranks_, 0);
+
+    // 1. Bucket entries by owner
+    std::vector<size_t> counts(n_ranks_, 0), offsets(n_ranks_, 0);
+    for (const auto& e : entries) {
+        counts[owner(row_partition_, e.i)]++;
+    }
+    for (int r = 1; r < n_ranks_; ++r) {
+        offsets[r] = offsets[r - 1] + counts[r - 1];
+    }
+    for (int r = 0; r < n_ranks_; ++r) {
+        send_counts[r] = to_count(counts[r]);
+        send_displs[r] = to_count(offsets[r]);
+    }
+    std::vector<Entry> send_buffer(entries.size());
+    for (const auto& e : entries) {
+        send_buffer[offsets[owner(row_partition_, e.i)]++] = e;
+    }
+
+    // 2. Exchange counts, then entries (counts are numbers of entries, see contiguous_type())
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, comm_);
+    size_t n_received = 0;
+    for (int r = 0; r < n_ranks_; ++r) {
+        recv_displs[r] = to_count(n_received);
+        n_received += recv_counts[r];
+    }
+    std::vector<Entry> received(n_received);
+
+    MPI_Alltoallv(send_buffer.data(), send_counts.data(), send_displs.data(), contiguous_type<Entry>(),
+                  received.data(), recv_counts.data(), recv_displs.data(), contiguous_type<Entry>(), comm_);
+    return received;
+}
+
+template<typename T>
+void DistributedMatrix<T>::build(const std::vector<Entry>& entries) {
+// Splits the local rows into the diagonal block (owned columns) and the off-diagonal block (ghost columns,
+// renumbered compactly in increasing global order), then builds the halo-exchange plan.
+
+    const size_t first_row = row_begin();
+    const size_t first_col = col_partition_[rank_];
+    const size_t last_col = col_partition_[rank_ + 1];
+
+    // 1. Ghost columns: sorted, unique global indices of the non-owned columns
+    ghost_cols_.clear();
+    for (const auto& e : entries) {
+        if (e.j < first_col || e.j >= last_col) {
+            ghost_cols_.push_back(e.j);
+        }
+    }
+    std::sort(ghost_cols_.begin(), ghost_cols_.end());
+    ghost_cols_.erase(std::unique(ghost_cols_.begin(), ghost_cols_.end()), ghost_cols_.end());
+
+    // 2. Diagonal and off-diagonal blocks
+    diag_block_ = Matrix<T, StorageOrder::RowMajor>(local_rows(), local_cols());
+    offdiag_block_ = Matrix<T, StorageOrder::RowMajor>(local_rows(), ghost_cols_.size());
+    for (const auto& e : entries) {
+        if (e.j >= first_col && e.j < last_col) {
+            diag_block_.update(e.i - first_row, e.j - first_col, e.value);
+        } else {
+            size_t ghost = std::lower_bound(ghost_cols_.begin(), ghost_cols_.end(), e.j) - ghost_cols_.begin();
+            offdiag_block_.update(e.i - first_row, ghost, e.value);
+        }
+    }
+    diag_block_.compress();
+    offdiag_block_.compress();
+
+    // 3. Receive side of the plan: ghosts are sorted, hence grouped by owner
+    recv_ranks_.clear();
+    recv_ptr_.assign(1, 0);
+    std::vector<int> recv_counts(n_ranks_, 0);
+    for (size_t g = 0; g < ghost_cols_.size(); ++g) {
+        int r = owner(col_partition_, ghost_cols_[g]);
+        if (recv_ranks_.empty() || recv_ranks_.back() != r) {
+            recv_ranks_.push_back(r);
+            recv_ptr_.push_back(recv_ptr_.back());
+        }
+        recv_ptr_.back()++;
+        recv_counts[r]++;
+    }
+
+    // 4. Send side: tell every owner which of its entries we need
+    std::vector<int> send_counts(n_ranks_, 0);
+    MPI_Alltoall(recv_counts.data(), 1, MPI_INT, send_counts.data(), 1, MPI_INT, comm_);
+
+    std::vector<int> recv_displs(n_ranks_, 0), send_displs(n_ranks_, 0);
+    for (int r = 1; r < n_ranks_; ++r) {
+        recv_displs[r] = recv_displs[r - 1] + recv_counts[r - 1];
+        send_displs[r] = send_displs[r - 1] + send_counts[r - 1];
+    }
+    std::vector<unsigned long long> requested(ghost_cols_.begin(), ghost_cols_.end());
+    std::vector<unsigned long long> to_send(send_displs[n_ranks_ - 1] + send_counts[n_ranks_ - 1]);
+    MPI_Alltoallv(requested.data(), recv_counts.data(), recv_displs.data(), MPI_UNSIGNED_LONG_LONG,
+                  to_send.data(), send_counts.data(), send_displs.data(), MPI_UNSIGNED_LONG_LONG, comm_);
+
+    send_ranks_.clear();
+    send_ptr_.assign(1, 0);
+    send_index_.resize(to_send.size());
+    for (int r = 0; r < n_ranks_; ++r) {
+        if (send_counts[r] == 0) continue;
+        send_ranks_.push_back(r);
+        send_ptr_.push_back(send_ptr_.back() + send_counts[r]);
+        for (int k = 0; k < send_counts[r]; ++k) {
+            send_index_[send_displs[r] + k] = to_send[send_displs[r] + k] - first_col; // global -> local
+        }
+    }
+
+    send_buffer_.resize(send_index_.size());
+    ghost_buffer_.resize(ghost_cols_.size());
+}
+
+template<typename T>
+void DistributedMatrix<T>::parse_entries(const std::string& chunk, std::vector<Entry>& entries) {
+// Parses "row col value" lines (1-based), skipping comments and empty lines.
+
+    std::istringstream iss(chunk);
+    std::string line;
+    while (std::getline(iss, line)) {
+        if (line.empty() || line[0] == '%') continue;
+        std::istringstream line_stream(line);
+        size_t row, col;
+        double value;
+        if (line_stream >> row >> col >> value) {
+            entries.push_back({row - 1, col - 1, T(value)});
+        }
+    }
+}
+
+// 🔥 CORE METHODS
+template<typename T>
+std::vector<T> DistributedMatrix<T>::product_by_vector(const std::vector<T>& x) const {
+// y = A_diag * x_local + A_offdiag * x_ghost, with the halo exchange of x_ghost overlapped with the first product.
+
+    if (x.size() != local_cols()) {
+        throw std::invalid_argument("Local vector size does not match the column partition.");
+    }
+
+    std::vector<MPI_Request> requests(recv_ranks_.size() + send_ranks_.size());
+    const int tag = 0;
+
+    // 1. Post receives for the ghost values
+    for (size_t n = 0; n < recv_ranks_.size(); ++n) {
+        MPI_Irecv(ghost_buffer_.data() + recv_ptr_[n], to_count(recv_ptr_[n + 1] - recv_ptr_[n]), contiguous_type<T>(),
+                  recv_ranks_[n], tag, comm_, &requests[n]);
+    }
+
+    // 2. Pack and send the values needed by the neighbours
+    for (size_t k = 0; k < send_index_.size(); ++k) {
+        send_buffer_[k] = x[send_index_[k]];
+    }
+    for (size_t n = 0; n < send_ranks_.size(); ++n) {
+        MPI_Isend(send_buffer_.data() + send_ptr_[n], to_count(send_ptr_[n + 1] - send_ptr_[n]), contiguous_type<T>(),
+                  send_ranks_[n], tag, comm_, &requests[recv_ranks_.size() + n]);
+    }
+
+    // 3. Local product while the messages are in flight
+    std::vector<T> y = diag_block_.product_by_vector(x);
+
+    // 4. Ghost contribution
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    if (!ghost_cols_.empty()) {
+        std::vector<T> y_ghost = offdiag_block_.product_by_vector(ghost_buffer_);
+        for (size_t i = 0; i < y.size(); ++i) {
+            y[i] += y_ghost[i];
+        }
+    }
+
+    return y;
+}
+
+template<typename T>
+std::vector<T> DistributedMatrix<T>::scatter(const std::vector<T>& global, int root) const {
+// Sends to every rank the entries of its column block.
+
+    std::vector<int> counts(n_ranks_), displs(n_ranks_);
+    for (int r = 0; r < n_ranks_; ++r) {
+        counts[r] = to_count(col_partition_[r + 1] - col_partition_[r]);
+        displs[r] = to_count(col_partition_[r]);
+    }
+    std::vector<T> local(local_cols());
+    MPI_Scatterv(global.data(), counts.data(), displs.data(), contiguous_type<T>(),
+                 local.data(), counts[rank_], contiguous_type<T>(), root, comm_);
+    return local;
+}
+
+template<typename T>
+std::vector<T> DistributedMatrix<T>::gather(const std::vector<T>& local, int root) const {
+// Collects the row blocks on the root.
+
+    std::vector<int> counts(n_ranks_), displs(n_ranks_);
+    for (int r = 0; r < n_ranks_; ++r) {
+        counts[r] = to_count(row_partition_[r + 1] - row_partition_[r]);
+        displs[r] = to_count(row_partition_[r]);
+    }
+    std::vector<T> global(rank_ == root ? rows_ : 0);
+    MPI_Gatherv(local.data(), counts[rank_], contiguous_type<T>(),
+                global.data(), counts.data(), displs.data(), contiguous_type<T>(), root, comm_);
+    return global;
+}
+
+// MATRIX MARKET PARALLEL LOADER
+template<typename T>
+bool DistributedMatrix<T>::mm_load_mtx(const std::string& filename) {
+// Loads a Matrix Market file in parallel.
+// .mtx: the root parses the header; each rank reads the lines starting inside its byte range of the data section,
+//       then the triplets are redistributed to the rank owning their row.
+// .mtx.gz: each rank inflates the whole file and keeps its rows (gzip streams cannot be entered at an arbitrary offset).
+
+    std::array<unsigned long long, 3> header = {0, 0, 0}; // rows, cols, offset of the first data line
+    std::vector<Entry> entries;
+    int ok = 1;
+
+    if (filename.ends_with(".mtx.gz")) {
+        std::string content;
+        gzFile file = gzopen(filename.c_str(), "rb");
+        if (file) {
+            char buffer[params::BUFFER_SIZE];
+            int bytes_read;
+            while ((bytes_read = gzread(file, buffer, params::BUFFER_SIZE)) > 0) {
+                content.append(buffer, bytes_read);
+            }
+            gzclose(file);
+        } else {
+            ok = 0;
+        }
+
+        std::istringstream iss(content);
+        std::string line;
+        while (ok && std::getline(iss, line)) {
+            if (line.empty() || line[0] == '%') continue;
+            std::istringstream header_line(line);
+            if (!(header_line >> header[0] >> header[1])) { ok = 0; }
+            header[2] = iss.tellg();
+            break;
+        }
+        MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm_);
+        if (!ok) {
+            if (rank_ == 0) { std::cerr << "Error: could not read file " << filename << std::endl; }
+            return false;
+        }
+
+        rows_ = header[0];
+        cols_ = header[1];
+        row_partition_ = block_partition(rows_);
+        col_partition_ = block_partition(cols_);
+
+        std::vector<Entry> all;
+        parse_entries(content.substr(header[2]), all);
+        for (const auto& e : all) {
+            if (e.i >= row_begin() && e.i < row_partition_[rank_ + 1]) {
+                entries.push_back(e);
+            }
+        }
+    }
+    else if (filename.ends_with(".mtx")) {
+        // 1. Header (root only)
+        unsigned long long file_size = 0;
+        if (rank_ == 0) {
+            std::ifstream ifs(filename);
+            std::string line;
+            ok = ifs.is_open();
+            while (ok && std::getline(ifs, line)) {
+                if (line.empty() || line[0] == '%') continue;
+                std::istringstream header_line(line);
+                if (!(header_line >> header[0] >> header[1])) { ok = 0; }
+                header[2] = ifs.tellg();
+                break;
+            }
+            ifs.clear();
+            ifs.seekg(0, std::ios::end);
+            file_size = ifs.tellg();
+        }
+        MPI_Bcast(&ok, 1, MPI_INT, 0, comm_);
+        if (!ok) {
+            if (rank_ == 0) { std::cerr << "Error: could not open file " << filename << std::endl; }
+            return false;
+        }
+        MPI_Bcast(header.data(), 3, MPI_UNSIGNED_LONG_LONG, 0, comm_);
+        MPI_Bcast(&file_size, 1, MPI_UNSIGNED_LONG_LONG, 0, comm_);
+
+        rows_ = header[0];
+        cols_ = header[1];
+        row_partition_ = block_partition(rows_);
+        col_partition_ = block_partition(cols_);
+
+        // 2. Byte range of this rank: the lines starting in [begin, end)
+        const unsigned long long data_size = file_size - header[2];
+        unsigned long long begin = header[2] + data_size * rank_ / n_ranks_;
+        unsigned long long end = header[2] + data_size * (rank_ + 1) / n_ranks_;
+
+        std::ifstream ifs(filename, std::ios::binary);
+        std::string chunk;
+        ok = ifs.is_open();
+        if (ok && begin < end) {
+            // a line starting before `begin` belongs to the previous rank
+            if (begin > header[2]) {
+                ifs.seekg(begin - 1);
+                if (ifs.get() != '\n') {
+                    std::string partial;
+                    std::getline(ifs, partial);
+                    begin = ifs.tellg();
+                }
+            }
+            if (!ifs) {
+                ok = 0; // seek or read of the line boundary failed
+            } else if (begin < end) {
+                ifs.seekg(begin);
+                chunk.resize(end - begin);
+                ifs.read(chunk.data(), chunk.size());
+                if (ifs.gcount() != static_cast<std::streamsize>(chunk.size())) {
+                    ok = 0; // short read: entries would be missing
+                }
+                // complete the last line, which may cross `end` (end of file is not an error here)
+                if (ok && !chunk.empty() && chunk.back() != '\n') {
+                    std::string rest;
+                    std::getline(ifs, rest);
+                    chunk += rest;
+                }
+            }
+        }
+
+        // every rank must have read its range, otherwise the matrix would silently miss entries
+        MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm_);
+        if (!ok) {
+            if (rank_ == 0) { std::cerr << "Error: could not read file " << filename << " on all ranks" << std::endl; }
+            return false;
+        }
+        std::vector<Entry> read;
+        parse_entries(chunk, read);
+
+        // 3. Send every triplet to the owner of its row
+        entries = redistribute(read);
+    }
+    else {
+        if (rank_ == 0) { std::cout << "Not a Matrix Market file..." << std::endl; }
+        return false;
+    }
+
+    build(entries);
+    return true;
+}
+
+// ℹ️ INFO & PRINTING METHODS
+template<typename T>
+void DistributedMatrix<T>::info() const {
+// Prints one line per rank, in rank order.
+
+    if (rank_ == 0) {
+        std::cout << std::string(50, '*') << std::endl;
+        std::cout << "*      Distributed Matrix Information Summary     *" << std::endl;
+        std::cout << std::string(50, '*') << std::endl;
+        std::cout << "  Size: " << rows_ << " x " << cols_ << ", ranks: " << n_ranks_ << std::endl;
+    }
+    for (int r = 0; r < n_ranks_; ++r) {
+        MPI_Barrier(comm_);
+        if (r == rank_) {
+            std::cout << "  Rank " << rank_ << ": rows [" << row_begin() << ", " << row_partition_[rank_ + 1] << ")"
+                      << ", nnz diag " << diag_block_.nnz() << ", nnz offdiag " << offdiag_block_.nnz()
+                      << ", ghosts " << n_ghosts() << ", recv from " << recv_ranks_.size()
+                      << ", send to " << send_ranks_.size() << " ranks" << std::endl;
+        }
+    }
+    MPI_Barrier(comm_);
+    if (rank_ == 0) {
+        std::cout << std::string(50, '*') << std::endl;
+    }
+}
+
+} // namespace algebra
@@ -0,0 +1,279 @@
+#ifndef EXPRESSION_HPP
+#define EXPRESSION_HPP
+
+#include <vector>
+#include <type_traits>
+#include <stdexcept>
+#include <algorithm>
+
+#include "Matrix.hpp"
+
+namespace algebra {
+
+/**
+ * @brief Base class (CRTP) of the lazy vector expressions.
+ *
+ * @tparam Derived Concrete expression type.
+ *
+ * An expression such as `A*x + B*z - alpha*w` is not computed when it is written: the operators only build
+ * a tree of lightweight nodes (holding references to the matrices and vectors), whose type encodes the whole
+ * expression. The tree is evaluated by assign(), in one fused sweep over blocks of rows writing straight into
+ * the destination.
+ *
+ * Every node provides:
+ * - `size()`: length of the resulting vector;
+ * - `add_rows(begin, end, coeff, y)`: adds coeff times the terms computable row by row (vectors, CSR products)
+ *   to y[begin .. end);
+ * - `scatter(coeff, y)`: adds coeff times the terms that are not computable row by row (CSC and uncompressed products) to y;
+ * - `aliases(p)`: whether the vector at address p is read by the expression (input of a matrix term or vector operand).
+ *
+ * Nodes hold references: the operands must outlive the expression (do not keep expressions built on temporaries).
+ */
+template<typename Derived>
+struct VectorExpression {
+
+    /**
+     * @brief Returns the concrete expression.
+     */
+    const Derived& derived() const { return static_cast<const Derived&>(*this); }
+
+    /**
+     * @brief Evaluates the expression into a new vector, so that `y = A*x + ...;` works on a std::vector.
+     *
+     * Use assign() to reuse the storage of an existing vector.
+     */
+    template<typename T>
+    operator std::vector<T>() const;
+};
+
+/**
+ * @brief True for the types derived from VectorExpression.
+ */
+template<typename E>
+inline constexpr bool is_vector_expression_v = std::is_base_of_v<VectorExpression<E>, E>;
+
+/**
+ * @brief A std::vector used as a leaf of an expression.
+ *
+ * @tparam T Type of the elements.
+ */
+template<typename T>
+class VectorOperand : public VectorExpression<VectorOperand<T>> {
+
+private:
+    const std::vector<T>& v_; ///< Referenced vector.
+
+public:
+    using value_type = T;
+
+    explicit VectorOperand(const std::vector<T>& v) : v_(v) {}
+
+    size_t size() const { return v_.size(); }
+    void add_rows(size_t begin, size_t end, const T& coeff, T* y) const {
+        for (size_t i = begin; i < end; ++i) { y[i] += coeff * v_[i]; }
+    }
+    void scatter(const T&, std::vector<T>&) const {}
+    bool aliases(const void* p) const { return p == static_cast<const void*>(&v_); } // assign() zeroes y before adding the terms
+};
+
+/**
+ * @brief The product of a Matrix by a vector, as a leaf of an expression.
+ *
+ * @tparam T Type of the elements.
+ * @tparam Order Storage order of the matrix.
+ *
+ * A compressed RowMajor (CSR) matrix contributes to the row sweep with the dot products of its rows.
+ * ColumnMajor (CSC) and uncompressed matrices cannot produce one row cheaply: they use the column (or COO)
+ * kernel of product_by_vector() to add their contribution in the scatter pass.
+ */
+template<typename T, StorageOrder Order>
+class MatrixVectorProduct : public VectorExpression<MatrixVectorProduct<T, Order>> {
+
+private:
+    const Matrix<T, Order>& A_; ///< Referenced matrix.
+    const std::vector<T>& x_;   ///< Referenced vector.
+    bool by_rows_;              ///< True if the matrix is compressed CSR.
+
+    // Raw arrays of the compressed matrix, so that the row kernel does not go through the references
+    const size_t* outer_ptr_ = nullptr;
+    const size_t* inner_index_ = nullptr;
+    const T* values_ = nullptr;
+    const T* x_data_ = nullptr;
+
+public:
+    using value_type = T;
+
+    /**
+     * @throws std::invalid_argument if the vector size does not match the matrix columns.
+     */
+    MatrixVectorProduct(const Matrix<T, Order>& A, const std::vector<T>& x);
+
+    size_t size() const { return A_.rows_; }
+    void add_rows(size_t begin, size_t end, const T& coeff, T* y) const;
+    void scatter(const T& coeff, std::vector<T>& y) const;
+    bool aliases(const void* p) const { return p == static_cast<const void*>(&x_); }
+};
+
+/**
+ * @brief A scalar times an expression.
+ *
+ * @tparam E Scaled expression.
+ */
+template<typename E>
+class ScaledExpression : public VectorExpression<ScaledExpression<E>> {
+
+public:
+    using value_type = typename E::value_type;
+
+private:
+    value_type alpha_; ///< Scalar factor.
+    E e_;              ///< Scaled expression (nodes are stored by value).
+
+public:
+    ScaledExpression(const value_type& alpha, const E& e) : alpha_(alpha), e_(e) {}
+
+    size_t size() const { return e_.size(); }
+    void add_rows(size_t begin, size_t end, const value_type& coeff, value_type* y) const { e_.add_rows(begin, end, coeff * alpha_, y); }
+    void scatter(const value_type& coeff, std::vector<value_type>& y) const { e_.scatter(coeff * alpha_, y); }
+    bool aliases(const void* p) const { return e_.aliases(p); }
+};
+
+/**
+ * @brief Sum (Sign = +1) or difference (Sign = -1) of two expressions.
+ *
+ * @tparam L Left expression.
+ * @tparam R Right expression.
+ * @tparam Sign Sign of the right expression.
+ */
+template<typename L, typename R, int Sign>
+class BinaryExpression : public VectorExpression<BinaryExpression<L, R, Sign>> {
+
+public:
+    using value_type = typename L::value_type;
+
+private:
+    L l_; ///< Left expression.
+    R r_; ///< Right expression.
+
+public:
+    /**
+     * @throws std::invalid_argument if the sizes of the two expressions differ.
+     */
+    BinaryExpression(const L& l, const R& r);
+
+    size_t size() const { return l_.size(); }
+    void add_rows(size_t begin, size_t end, const value_type& coeff, value_type* y) const;
+    void scatter(const value_type& coeff, std::vector<value_type>& y) const;
+    bool aliases(const void* p) const { return l_.aliases(p) || r_.aliases(p); }
+};
+
+// 🔥 EVALUATION
+
+/**
+ * @brief Evaluates an expression into y (resized if needed), in one fused sweep.
+ *
+ * The rows are processed in blocks of params::EXPRESSION_BLOCK_SIZE, in an OpenMP parallel loop (same threshold
+ * as product_by_vector()): for each block the vector and CSR terms are accumulated one after the other into the
+ * block of y, which stays in cache, so each term runs its own row kernel on contiguous rows.
+ * CSC and uncompressed terms are then accumulated into y with their column (or COO) kernel. No intermediate vector is allocated, unless y is itself read by the expression
+ * (e.g. `y = A*y` or `y = y + alpha*w`), in which case the expression is evaluated into a temporary that is then swapped with y.
+ *
+ * @param y Destination.
+ * @param expr Expression.
+ */
+template<typename T, typename E>
+void assign(std::vector<T>& y, const VectorExpression<E>& expr);
+
+/**
+ * @brief Evaluates an expression into a new vector.
+ */
+template<typename E>
+std::vector<typename E::value_type> evaluate(const VectorExpression<E>& expr);
+
+// OPERATORS
+
+/**
+ * @brief Lazy product of a matrix by a vector.
+ */
+template<typename T, StorageOrder Order>
+MatrixVectorProduct<T, Order> operator*(const Matrix<T, Order>& A, const std::vector<T>& x) {
+    return MatrixVectorProduct<T, Order>(A, x);
+}
+
+/**
+ * @brief Lazy product of a scalar by a vector.
+ */
+template<typename T>
+ScaledExpression<VectorOperand<T>> operator*(const std::type_identity_t<T>& alpha, const std::vector<T>& v) {
+    return ScaledExpression<VectorOperand<T>>(alpha, VectorOperand<T>(v));
+}
+
+/**
+ * @brief Lazy product of a scalar by an expression.
+ */
+template<typename E>
+ScaledExpression<E> operator*(const typename E::value_type& alpha, const VectorExpression<E>& e) {
+    return ScaledExpression<E>(alpha, e.derived());
+}
+
+/**
+ * @brief Lazy opposite of an expression.
+ */
+template<typename E>
+ScaledExpression<E> operator-(const VectorExpression<E>& e) {
+    return ScaledExpression<E>(typename E::value_type(-1), e.derived());
+}
+
+/**
+ * @brief Lazy sum of two expressions.
+ */
+template<typename L, typename R>
+BinaryExpression<L, R, 1> operator+(const VectorExpression<L>& l, const VectorExpression<R>& r) {
+    return BinaryExpression<L, R, 1>(l.derived(), r.derived());
+}
+
+/**
+ * @brief Lazy difference of two expressions.
+ */
+template<typename L, typename R>
+BinaryExpression<L, R, -1> operator-(const VectorExpression<L>& l, const VectorExpression<R>& r) {
+    return BinaryExpression<L, R, -1>(l.derived(), r.derived());
+}
+
+/**
+ * @brief Lazy sum of an expression and a vector.
+ */
+template<typename L>
+BinaryExpression<L, VectorOperand<typename L::value_type>, 1> operator+(const VectorExpression<L>& l, const std::vector<typename L::value_type>& v) {
+    return {l.derived(), VectorOperand<typename L::value_type>(v)};
+}
+
+/**
+ * @brief Lazy sum of a vector and an expression.
+ */
+template<typename R>
+BinaryExpression<VectorOperand<typename R::value_type>, R, 1> operator+(const std::vector<typename R::value_type>& v, const VectorExpression<R>& r) {
+    return {VectorOperand<typename R::value_type>(v), r.derived()};
+}
+
+/**
+ * @brief Lazy difference of an expression and a vector.
+ */
+template<typename L>
+BinaryExpression<L, VectorOperand<typename L::value_type>, -1> operator-(const VectorExpression<L>& l, const std::vector<typename L::value_type>& v) {
+    return {l.derived(), VectorOperand<typename L::value_type>(v)};
+}
+
+/**
+ * @brief Lazy difference of a vector and an expression.
+ */
+template<typename R>
+BinaryExpression<VectorOperand<typename R::value_type>, R, -1> operator-(const std::vector<typename R::value_type>& v, const VectorExpression<R>& r) {
+    return {VectorOperand<typename R::value_type>(v), r.derived()};
+}
+
+} // namespace algebra
+
+#include "Expression.tpp" // methods implementation
+
+#endif // EXPRESSION_HPP
@@ -0,0 +1,146 @@
+/* This .tpp file contains the implementation of the lazy vector expressions.
+It defines the row and scatter kernels of the expression nodes and the fused evaluation into a destination vector.
+ */
+#include "Expression.hpp"
+
+namespace algebra{
+
+// EXPRESSION NODES
+template<typename Derived>
+template<typename T>
+VectorExpression<Derived>::operator std::vector<T>() const {
+    std::vector<T> y;
+    assign(y, derived());
+    return y;
+}
+
+template<typename T, StorageOrder Order>
+MatrixVectorProduct<T, Order>::MatrixVectorProduct(const Matrix<T, Order>& A, const std::vector<T>& x)
+    : A_(A), x_(x), by_rows_(Order == StorageOrder::RowMajor && A.is_compressed()) {
+    if (x.size() != A.cols_) {
+        throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+    }
+    if (by_rows_) {
+        outer_ptr_ = A.compressed_data_.outer_ptr.data();
+        inner_index_ = A.compressed_data_.inner_index.data();
+        values_ = A.compressed_data_.values.data();
+        x_data_ = x.data();
+    }
+}
+
+template<typename T, StorageOrder Order>
+void MatrixVectorProduct<T, Order>::add_rows(size_t begin, size_t end, const T& coeff, T* y) const {
+// RowMajor (CSR): dot products of rows [begin, end); other formats contribute in the scatter pass.
+
+    if (!by_rows_) {
+        return;
+    }
+    for (size_t i = begin; i < end; ++i) {
+        T sum = 0;
+        for (size_t k = outer_ptr_[i]; k < outer_ptr_[i + 1]; ++k) {
+            sum += values_[k] * x_data_[inner_index_[k]];
+        }
+        y[i] += coeff * sum;
+    }
+}
+
+template<typename T, StorageOrder Order>
+void MatrixVectorProduct<T, Order>::scatter(const T& coeff, std::vector<T>& y) const {
+// Adds coeff * A * x to y for the terms that are not computed row by row.
+
+    if (by_rows_) {
+        return;
+    }
+
+    if (!A_.is_compressed()) {
+        // Uncompressed (COO): iterate over the map
+        for (const auto& [key, val] : A_.sparse_data_) {
+            y[key[0]] += coeff * val * x_[key[1]];
+        }
+        return;
+    }
+
+    // ColumnMajor (CSC): traverse column by column (parallel with atomics for arithmetic types, as in product_by_vector)
+    const auto& data = A_.compressed_data_;
+    if constexpr (std::is_arithmetic_v<T>) {
+        #pragma omp parallel for if(A_.cols_ >= params::NCOLS_PARALLELIZATON_LIMIT)
+        for (size_t j = 0; j < A_.cols_; ++j) {
+            const T cx = coeff * x_[j];
+            for (size_t k = data.outer_ptr[j]; k < data.outer_ptr[j + 1]; ++k) {
+                #pragma omp atomic
+                y[data.inner_index[k]] += data.values[k] * cx;
+            }
+        }
+    } else {
+        for (size_t j = 0; j < A_.cols_; ++j) {
+            const T cx = coeff * x_[j];
+            for (size_t k = data.outer_ptr[j]; k < data.outer_ptr[j + 1]; ++k) {
+                y[data.inner_index[k]] += data.values[k] * cx;
+            }
+        }
+    }
+}
+
+template<typename L, typename R, int Sign>
+BinaryExpression<L, R, Sign>::BinaryExpression(const L& l, const R& r) : l_(l), r_(r) {
+    if (l.size() != r.size()) {
+        throw std::invalid_argument("Vector expression operands have different sizes.");
+    }
+}
+
+template<typename L, typename R, int Sign>
+void BinaryExpression<L, R, Sign>::add_rows(size_t begin, size_t end, const value_type& coeff, value_type* y) const {
+    l_.add_rows(begin, end, coeff, y);
+    r_.add_rows(begin, end, Sign > 0 ? coeff : -coeff, y);
+}
+
+template<typename L, typename R, int Sign>
+void BinaryExpression<L, R, Sign>::scatter(const value_type& coeff, std::vector<value_type>& y) const {
+    l_.scatter(coeff, y);
+    r_.scatter(Sign > 0 ? coeff : -coeff, y);
+}
+
+// 🔥 EVALUATION
+template<typename T, typename E>
+void assign(std::vector<T>& y, const VectorExpression<E>& expr) {
+// 1. If y is read by the expression, evaluates into a temporary (y would be zeroed or overwritten while being read).
+// 2. Fused sweep over blocks of rows: each block of y is zeroed, then every row-computable term is added to it
+//    while the block is in cache (parallel over the blocks for large vectors).
+// 3. Scatter pass for the CSC and uncompressed terms.
+
+    static_assert(std::is_same_v<T, typename E::value_type>, "Destination and expression types differ.");
+    const E& e = expr.derived();
+
+    if (e.aliases(&y)) {
+        std::vector<T> tmp;
+        assign(tmp, expr);
+        y.swap(tmp);
+        return;
+    }
+
+    const size_t n = e.size();
+    y.resize(n);
+
+    constexpr size_t block = params::EXPRESSION_BLOCK_SIZE;
+    const size_t n_blocks = (n + block - 1) / block;
+    T* out = y.data();
+
+    #pragma omp parallel for schedule(static) if(n >= params::NROWS_PARALLELIZATON_LIMIT)
+    for (size_t b = 0; b < n_blocks; ++b) {
+        const size_t begin = b * block;
+        const size_t end = std::min(n, begin + block);
+        std::fill(out + begin, out + end, T(0));
+        e.add_rows(begin, end, T(1), out);
+    }
+
+    e.scatter(T(1), y);
+}
+
+template<typename E>
+std::vector<typename E::value_type> evaluate(const VectorExpression<E>& expr) {
+    std::vector<typename E::value_type> y;
+    assign(y, expr);
+    return y;
+}
+
+} // namespace algebra
@@ -0,0 +1,147 @@
+#ifndef INDEXARRAY_HPP
+#define INDEXARRAY_HPP
+
+#include <memory>
+#include <memory_resource>
+#include <vector>
+#include <cstddef>
+
+namespace algebra {
+
+/**
+ * @brief Index array (outer pointers or inner indices) of a compressed matrix, either owned or shared.
+ *
+ * An owned array is a polymorphic-allocator vector, allocated with the policy of the owning CompressedMatrix.
+ * A shared array is an immutable view on the index array of a frozen SparsityPattern: all the matrices attached
+ * to the pattern read the same memory, and only their values are stored separately.
+ *
+ * Read access is the same in both cases (operator[], data(), begin()/end() all return const data). Writes go
+ * through mutable_data() or through the vector-like mutators (assign(), resize(), ...), which first detach a
+ * shared array into an owned copy, so a shared array is never modified.
+ */
+class IndexArray {
+
+private:
+    std::pmr::vector<size_t> owned_;                     ///< Own storage (empty while the array is shared).
+    std::shared_ptr<const std::vector<size_t>> shared_;  ///< Shared storage (null while the array is owned).
+
+    const size_t* data_ = nullptr; ///< Current storage (owned or shared), cached for the read accessors.
+    size_t size_ = 0;              ///< Number of indices of the current storage.
+
+    /**
+     * @brief Refreshes the cached pointer and size after a change of storage.
+     */
+    void sync() {
+        data_ = shared_ ? shared_->data() : owned_.data();
+        size_ = shared_ ? shared_->size() : owned_.size();
+    }
+
+    /**
+     * @brief Turns a shared array into an owned copy (no-op if the array is owned).
+     */
+    void detach() {
+        if (shared_) {
+            owned_.assign(shared_->begin(), shared_->end());
+            shared_.reset();
+        }
+    }
+
+public:
+    using value_type = size_t;
+    using const_iterator = const size_t*;
+
+    /**
+     * @brief Constructs an empty owned array allocated from the given memory resource.
+     */
+    explicit IndexArray(std::pmr::memory_resource* res = std::pmr::get_default_resource()) : owned_(res) {}
+
+    /**
+     * @brief Takes over the storage of other (the allocator of an owned array moves with it); other is left empty.
+     */
+    IndexArray(IndexArray&& other) noexcept : owned_(std::move(other.owned_)), shared_(std::move(other.shared_)) {
+        sync();
+        other.owned_.clear();
+        other.shared_.reset();
+        other.sync();
+    }
+
+    IndexArray(const IndexArray&) = delete;
+    IndexArray& operator=(const IndexArray&) = delete;
+    IndexArray& operator=(IndexArray&&) = delete;
+
+    // 📖 READ ACCESS
+
+    size_t operator[](size_t k) const { return data_[k]; }
+    const size_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t back() const { return data_[size_ - 1]; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+    /**
+     * @brief Returns the shared storage, or nullptr if the array is owned.
+     */
+    const std::shared_ptr<const std::vector<size_t>>& shared() const { return shared_; }
+
+    // ✏️ WRITE ACCESS
+
+    /**
+     * @brief Makes the array a view on shared storage, releasing the owned storage.
+     */
+    void share(std::shared_ptr<const std::vector<size_t>> storage) {
+        owned_.clear();
+        owned_.shrink_to_fit();
+        shared_ = std::move(storage);
+        sync();
+    }
+
+    /**
+     * @brief Returns a writable pointer to the indices (a shared array is detached first).
+     */
+    size_t* mutable_data() {
+        detach();
+        sync();
+        return owned_.data();
+    }
+
+    template<typename InputIt>
+    void assign(InputIt first, InputIt last) {
+        shared_.reset();
+        owned_.assign(first, last);
+        sync();
+    }
+
+    void assign(size_t n, size_t value) {
+        shared_.reset();
+        owned_.assign(n, value);
+        sync();
+    }
+
+    void resize(size_t n) {
+        detach();
+        owned_.resize(n);
+        sync();
+    }
+
+    void reserve(size_t n) {
+        detach();
+        owned_.reserve(n);
+        sync();
+    }
+
+    void clear() {
+        shared_.reset();
+        owned_.clear();
+        sync();
+    }
+
+    void shrink_to_fit() {
+        owned_.shrink_to_fit();
+        sync();
+    }
+};
+
+} // namespace algebra
+
+#endif // INDEXARRAY_HPP
@@ -0,0 +1,195 @@
+#ifndef INDEXCOMPRESSEDMATRIX_HPP
+#define INDEXCOMPRESSEDMATRIX_HPP
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Matrix.hpp"
+
+namespace algebra {
+
+/**
+ * @brief Read-only compressed matrix (CSR or CSC) whose inner indices are delta-encoded on 8 or 16 bits.
+ *
+ * @tparam T Type of the matrix elements.
+ * @tparam Order Storage order (RowMajor for CSR, ColumnMajor for CSC).
+ *
+ * After the values, the inner_index array (one size_t per nonzero) is the largest array streamed by a
+ * matrix-vector product. Inside a row (CSR) or column (CSC) the inner indices are sorted and, for mesh-like
+ * matrices, close to each other and to the diagonal, so they are stored as small deltas:
+ * - the first entry of outer index o is stored as the zigzag-encoded difference inner - o;
+ * - every following entry is stored as the difference from the previous inner index.
+ *
+ * Deltas are stored on 8 or 16 bits (chosen to minimise the size unless forced). Deltas that do not fit
+ * (outliers) are replaced by the escape code (the largest value of the delta type) and their full inner index
+ * is stored in a separate escape array, with per-outer-index escape pointers. When no delta overflows the
+ * escape arrays are empty and the products use kernels without escape checks.
+ *
+ * The products decode the indices on the fly, keeping the running index in a register.
+ */
+template<typename T, StorageOrder Order>
+class IndexCompressedMatrix {
+
+private:
+    size_t rows_; ///< Number of rows.
+    size_t cols_; ///< Number of columns.
+
+    std::vector<T> values_;         ///< Nonzero values (same order as in the compressed Matrix).
+    std::vector<size_t> outer_ptr_; ///< Row (CSR) or column (CSC) pointers.
+
+    unsigned bits_;                  ///< Width of the deltas (8 or 16).
+    std::vector<uint8_t> deltas8_;   ///< Deltas, if bits_ == 8.
+    std::vector<uint16_t> deltas16_; ///< Deltas, if bits_ == 16.
+
+    std::vector<size_t> escape_ptr_; ///< Escapes of outer index o are escapes_[escape_ptr_[o] .. escape_ptr_[o+1]) (empty if none).
+    std::vector<size_t> escapes_;    ///< Full inner index of each escaped entry.
+
+    // 🔒 PRIVATE METHODS
+
+    /**
+     * @brief Zigzag encoding of a signed difference (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...).
+     */
+    static size_t zigzag(size_t inner, size_t outer) { return inner >= outer ? 2 * (inner - outer) : 2 * (outer - inner) - 1; }
+
+    /**
+     * @brief Counts the deltas that do not fit in type D (the escape code included), given outer_ptr_.
+     *
+     * @param inner_index Inner indices of the matrix being encoded.
+     */
+    template<typename D>
+    size_t count_escapes(const size_t* inner_index) const;
+
+    /**
+     * @brief Encodes the inner indices with deltas of type D, given outer_ptr_.
+     *
+     * @param inner_index Inner indices of the matrix being encoded.
+     * @param deltas Output: the deltas.
+     * @param with_escapes Whether to build the escape arrays (false if no delta overflows).
+     */
+    template<typename D>
+    void encode(const size_t* inner_index, std::vector<D>& deltas, bool with_escapes);
+
+    /**
+     * @brief Decodes the inner indices of outer index o and calls f(k, inner) for each entry k.
+     *
+     * @tparam D Delta type.
+     * @tparam Escapes Whether escape codes may occur.
+     */
+    template<typename D, bool Escapes, typename F>
+    void for_each_entry(const D* deltas, size_t o, F&& f) const;
+
+    /**
+     * @brief Product kernel for one delta type and escape variant.
+     */
+    template<typename D, bool Escapes, bool Parallel>
+    void product_kernel(const D* deltas, const std::vector<T>& v, std::vector<T>& output) const;
+
+    /**
+     * @brief Dispatches a product to the kernel matching the delta width and the presence of escapes.
+     */
+    template<bool Parallel>
+    std::vector<T> dispatch_product(const std::vector<T>& v) const;
+
+public:
+    // 🏗️ CONSTRUCTORS
+
+    /**
+     * @brief Encodes a matrix (compressed on a copy if it is not compressed).
+     *
+     * @param mat Matrix to encode.
+     * @param bits Width of the deltas: 8, 16, or 0 to choose the one giving the smallest storage.
+     * @throws std::invalid_argument if bits is not 0, 8 or 16.
+     */
+    explicit IndexCompressedMatrix(const Matrix<T, Order>& mat, unsigned bits = 0);
+
+    // 🔥 CORE METHODS
+
+    /**
+     * @brief Multiplies the matrix by a vector, serially.
+     *
+     * @param v Input vector (size = columns).
+     * @return Result vector (size = rows).
+     */
+    std::vector<T> compressed_product_by_vector(const std::vector<T>& v) const;
+
+    /**
+     * @brief Multiplies the matrix by a vector in parallel using OpenMP.
+     *
+     * @param v Input vector (size = columns).
+     * @return Result vector (size = rows).
+     */
+    std::vector<T> compressed_product_by_vector_parallel(const std::vector<T>& v) const;
+
+    /**
+     * @brief Multiplies the matrix by a vector, in parallel above the same thresholds as Matrix::product_by_vector().
+     *
+     * @param v Input vector (size = columns).
+     * @return Result vector (size = rows).
+     * @throws std::invalid_argument if the vector size does not match the columns.
+     */
+    std::vector<T> product_by_vector(const std::vector<T>& v) const;
+
+    /**
+     * @brief Decodes the matrix back into a compressed Matrix with plain size_t indices.
+     */
+    Matrix<T, Order> decode() const;
+
+    // ℹ️ INFO & PRINTING METHODS
+
+    /**
+     * @brief Returns the memory usage of the encoded arrays in bytes.
+     */
+    size_t weight() const;
+
+    /**
+     * @brief Returns the memory usage (bytes) of the same matrix stored with plain size_t indices.
+     */
+    size_t plain_weight() const;
+
+    /**
+     * @brief Returns plain_weight() / weight().
+     */
+    double compression_ratio() const { return static_cast<double>(plain_weight()) / weight(); }
+
+    /**
+     * @brief Returns the compression ratio of the index arrays alone (inner_index vs deltas + escapes).
+     */
+    double index_compression_ratio() const;
+
+    /**
+     * @brief Returns the width of the deltas (8 or 16).
+     */
+    unsigned index_bits() const { return bits_; }
+
+    /**
+     * @brief Returns the number of escaped entries.
+     */
+    size_t n_escapes() const { return escapes_.size(); }
+
+    /**
+     * @brief Returns the number of stored entries.
+     */
+    size_t nnz() const { return values_.size(); }
+
+    /**
+     * @brief Returns the dimensions of the matrix.
+     */
+    std::array<size_t, 2> size() const { return {rows_, cols_}; }
+
+    /**
+     * @brief Prints a summary: size, delta width, escapes, weight and compression ratios.
+     */
+    void info() const;
+};
+
+} // namespace algebra
+
+#include "IndexCompressedMatrix.tpp" // methods implementation
+
+#endif // INDEXCOMPRESSEDMATRIX_HPP
@@ -0,0 +1,287 @@
+/* This .tpp file contains the implementation of the IndexCompressedMatrix class template.
+It defines the delta encoding of the inner indices (8/16-bit deltas with escapes), the decoding
+matrix-vector product kernels and the memory usage / compression ratio reports.
+ */
+#include "IndexCompressedMatrix.hpp"
+
+namespace algebra{
+
+// 🏗️ CONSTRUCTORS
+template<typename T, StorageOrder Order>
+IndexCompressedMatrix<T, Order>::IndexCompressedMatrix(const Matrix<T, Order>& mat, unsigned bits)
+    : rows_(mat.rows_), cols_(mat.cols_), bits_(bits) {
+// 1. Takes the compressed arrays of the matrix (compressing a copy if needed).
+// 2. Chooses the delta width: the one giving the smallest deltas + escapes storage, unless forced.
+// 3. Encodes the inner indices; the escape arrays are built only if some delta overflows.
+
+    if (bits != 0 && bits != 8 && bits != 16) {
+        throw std::invalid_argument("Index delta width must be 0 (automatic), 8 or 16 bits.");
+    }
+
+    constexpr bool isRowMajor = (Order == StorageOrder::RowMajor);
+    const size_t outer_size = isRowMajor ? rows_ : cols_;
+
+    const CompressedMatrix<T>* data = &mat.compressed_data_;
+    Matrix<T, Order> copy(0, 0);
+    if (!mat.is_compressed()) {
+        copy = mat;
+        copy.compress();
+        data = &copy.compressed_data_;
+    }
+
+    // 1. Values and outer pointers are kept as they are
+    values_.assign(data->values.begin(), data->values.end());
+    if (data->outer_ptr.empty()) {
+        outer_ptr_.assign(outer_size + 1, 0); // empty matrix
+    } else {
+        outer_ptr_.assign(data->outer_ptr.begin(), data->outer_ptr.end());
+    }
+    const size_t* inner_index = data->inner_index.data();
+    const size_t nnz = values_.size();
+
+    // 2. Delta width
+    const size_t escapes8 = count_escapes<uint8_t>(inner_index);
+    const size_t escapes16 = count_escapes<uint16_t>(inner_index);
+    if (bits_ == 0) {
+        auto bytes = [&](size_t width, size_t escapes) {
+            return width * nnz + (escapes > 0 ? sizeof(size_t) * (outer_size + 1 + escapes) : 0);
+        };
+        bits_ = bytes(1, escapes8) <= bytes(2, escapes16) ? 8 : 16;
+    }
+
+    // 3. Encoding
+    if (bits_ == 8) {
+        encode(inner_index, deltas8_, escapes8 > 0);
+    } else {
+        encode(inner_index, deltas16_, escapes16 > 0);
+    }
+}
+
+// 🔒 PRIVATE METHODS
+template<typename T, StorageOrder Order>
+template<typename D>
+size_t IndexCompressedMatrix<T, Order>::count_escapes(const size_t* inner_index) const {
+// A delta needs an escape if it is not smaller than the escape code (the largest value of D).
+
+    constexpr size_t escape = std::numeric_limits<D>::max();
+    size_t count = 0;
+    for (size_t o = 0; o + 1 < outer_ptr_.size(); ++o) {
+        for (size_t k = outer_ptr_[o]; k < outer_ptr_[o + 1]; ++k) {
+            size_t delta = (k == outer_ptr_[o]) ? zigzag(inner_index[k], o) : inner_index[k] - inner_index[k - 1];
+            count += (delta >= escape);
+        }
+    }
+    return count;
+}
+
+template<typename T, StorageOrder Order>
+template<typename D>
+void IndexCompressedMatrix<T, Order>::encode(const size_t* inner_index, std::vector<D>& deltas, bool with_escapes) {
+// First entry of each outer index: zigzag(inner - outer); next entries: difference from the previous inner index.
+// Deltas that do not fit are written as the escape code, with the full index appended to escapes_.
+
+    constexpr size_t escape = std::numeric_limits<D>::max();
+    const size_t outer_size = outer_ptr_.size() - 1;
+
+    deltas.resize(values_.size());
+    if (with_escapes) {
+        escape_ptr_.assign(outer_size + 1, 0);
+    }
+
+    for (size_t o = 0; o < outer_size; ++o) {
+        if (with_escapes) {
+            escape_ptr_[o] = escapes_.size();
+        }
+        for (size_t k = outer_ptr_[o]; k < outer_ptr_[o + 1]; ++k) {
+            size_t delta = (k == outer_ptr_[o]) ? zigzag(inner_index[k], o) : inner_index[k] - inner_index[k - 1];
+            if (with_escapes && delta >= escape) {
+                deltas[k] = static_cast<D>(escape);
+                escapes_.push_back(inner_index[k]);
+            } else {
+                deltas[k] = static_cast<D>(delta);
+            }
+        }
+    }
+    if (with_escapes) {
+        escape_ptr_[outer_size] = escapes_.size();
+    }
+}
+
+template<typename T, StorageOrder Order>
+template<typename D, bool Escapes, typename F>
+inline void IndexCompressedMatrix<T, Order>::for_each_entry(const D* deltas, size_t o, F&& f) const {
+// Decodes the entries of outer index o in order, keeping the running inner index in a register.
+// The first entry is peeled off, since it is relative to o (zigzag) instead of the previous index.
+
+    size_t k = outer_ptr_[o];
+    const size_t end = outer_ptr_[o + 1];
+    if (k == end) {
+        return;
+    }
+
+    constexpr D escape = std::numeric_limits<D>::max();
+    size_t e = Escapes ? escape_ptr_[o] : 0;
+
+    D d = deltas[k];
+    size_t inner;
+    if (Escapes && d == escape) {
+        inner = escapes_[e++];
+    } else {
+        inner = o + ((size_t(d) >> 1) ^ (size_t(0) - (d & 1))); // branchless zigzag decoding (modular arithmetic)
+    }
+    f(k, inner);
+
+    for (++k; k < end; ++k) {
+        d = deltas[k];
+        if (Escapes && d == escape) {
+            inner = escapes_[e++];
+        } else {
+            inner += d;
+        }
+        f(k, inner);
+    }
+}
+
+template<typename T, StorageOrder Order>
+template<typename D, bool Escapes, bool Parallel>
+void IndexCompressedMatrix<T, Order>::product_kernel(const D* deltas, const std::vector<T>& v, std::vector<T>& output) const {
+// Same traversal as Matrix::compressed_product_by_vector(_parallel), decoding the inner indices on the fly.
+
+    if constexpr (Order == StorageOrder::RowMajor) {
+        // RowMajor (CSR): traverse row by row
+        #pragma omp parallel for if(Parallel)
+        for (size_t i = 0; i < rows_; ++i) {
+            T sum = 0;
+            for_each_entry<D, Escapes>(deltas, i, [&](size_t k, size_t j) { sum += values_[k] * v[j]; });
+            output[i] = sum;
+        }
+    } else if constexpr (Parallel && std::is_arithmetic_v<T>) {
+        // ColumnMajor (CSC): traverse column by column (parallel, atomic updates of the output)
+        #pragma omp parallel for
+        for (size_t j = 0; j < cols_; ++j) {
+            for_each_entry<D, Escapes>(deltas, j, [&](size_t k, size_t i) {
+                #pragma omp atomic
+                output[i] += values_[k] * v[j];
+            });
+        }
+    } else {
+        // ColumnMajor (CSC): traverse column by column
+        for (size_t j = 0; j < cols_; ++j) {
+            for_each_entry<D, Escapes>(deltas, j, [&](size_t k, size_t i) { output[i] += values_[k] * v[j]; });
+        }
+    }
+}
+
+template<typename T, StorageOrder Order>
+template<bool Parallel>
+std::vector<T> IndexCompressedMatrix<T, Order>::dispatch_product(const std::vector<T>& v) const {
+// Selects the kernel instantiation: delta width x presence of escapes.
+
+    std::vector<T> output(rows_, T(0));
+    const bool escapes = !escape_ptr_.empty();
+    if (bits_ == 8) {
+        escapes ? product_kernel<uint8_t, true, Parallel>(deltas8_.data(), v, output)
+                : product_kernel<uint8_t, false, Parallel>(deltas8_.data(), v, output);
+    } else {
+        escapes ? product_kernel<uint16_t, true, Parallel>(deltas16_.data(), v, output)
+                : product_kernel<uint16_t, false, Parallel>(deltas16_.data(), v, output);
+    }
+    return output;
+}
+
+// 🔥 CORE METHODS
+template<typename T, StorageOrder Order>
+std::vector<T> IndexCompressedMatrix<T, Order>::compressed_product_by_vector(const std::vector<T>& v) const {
+    return dispatch_product<false>(v);
+}
+
+template<typename T, StorageOrder Order>
+std::vector<T> IndexCompressedMatrix<T, Order>::compressed_product_by_vector_parallel(const std::vector<T>& v) const {
+    return dispatch_product<true>(v);
+}
+
+template<typename T, StorageOrder Order>
+std::vector<T> IndexCompressedMatrix<T, Order>::product_by_vector(const std::vector<T>& v) const {
+// Uses the parallel kernel above the row (CSR) or column (CSC) thresholds, as Matrix::product_by_vector().
+
+    if (v.size() != cols_) {
+        throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+    }
+    const size_t outer_size = (Order == StorageOrder::RowMajor) ? rows_ : cols_;
+    const size_t limit = (Order == StorageOrder::RowMajor) ? params::NROWS_PARALLELIZATON_LIMIT : params::NCOLS_PARALLELIZATON_LIMIT;
+    return outer_size >= limit ? compressed_product_by_vector_parallel(v) : compressed_product_by_vector(v);
+}
+
+template<typename T, StorageOrder Order>
+Matrix<T, Order> IndexCompressedMatrix<T, Order>::decode() const {
+// Rebuilds the plain compressed arrays of a Matrix.
+
+    Matrix<T, Order> mat(rows_, cols_);
+    if (values_.empty()) {
+        return mat;
+    }
+
+    auto& data = mat.compressed_data_;
+    data.outer_ptr.assign(outer_ptr_.begin(), outer_ptr_.end());
+    data.values.assign(values_.begin(), values_.end());
+    data.inner_index.resize(values_.size());
+    size_t* inner_index = data.inner_index.mutable_data();
+
+    auto decode_all = [&]<typename D>(const std::vector<D>& deltas) {
+        for (size_t o = 0; o + 1 < outer_ptr_.size(); ++o) {
+            if (escape_ptr_.empty()) {
+                for_each_entry<D, false>(deltas.data(), o, [&](size_t k, size_t inner) { inner_index[k] = inner; });
+            } else {
+                for_each_entry<D, true>(deltas.data(), o, [&](size_t k, size_t inner) { inner_index[k] = inner; });
+            }
+        }
+    };
+    if (bits_ == 8) {
+        decode_all(deltas8_);
+    } else {
+        decode_all(deltas16_);
+    }
+    return mat;
+}
+
+// ℹ️ INFO & PRINTING METHODS
+template<typename T, StorageOrder Order>
+size_t IndexCompressedMatrix<T, Order>::weight() const {
+    return values_.size() * sizeof(T) + outer_ptr_.size() * sizeof(size_t)
+         + deltas8_.size() * sizeof(uint8_t) + deltas16_.size() * sizeof(uint16_t)
+         + escape_ptr_.size() * sizeof(size_t) + escapes_.size() * sizeof(size_t);
+}
+
+template<typename T, StorageOrder Order>
+size_t IndexCompressedMatrix<T, Order>::plain_weight() const {
+// Same formula as Matrix::weight() for a compressed matrix.
+
+    return values_.size() * sizeof(T) + values_.size() * sizeof(size_t) + outer_ptr_.size() * sizeof(size_t);
+}
+
+template<typename T, StorageOrder Order>
+double IndexCompressedMatrix<T, Order>::index_compression_ratio() const {
+    size_t encoded = deltas8_.size() * sizeof(uint8_t) + deltas16_.size() * sizeof(uint16_t)
+                   + escape_ptr_.size() * sizeof(size_t) + escapes_.size() * sizeof(size_t);
+    return encoded == 0 ? 1.0 : static_cast<double>(values_.size() * sizeof(size_t)) / encoded;
+}
+
+template<typename T, StorageOrder Order>
+void IndexCompressedMatrix<T, Order>::info() const {
+// Prints a summary of the encoded matrix to std::cout.
+
+    std::cout << std::string(50, '*') << std::endl;
+    std::cout << "*      Index-Compressed Matrix Information       *" << std::endl;
+    std::cout << std::string(50, '*') << std::endl;
+    std::cout << std::left;
+    std::cout << std::setw(30) << "  Size:" << rows_ << " x " << cols_ << std::endl;
+    std::cout << std::setw(30) << "  Storage Order:" << storageOrderToString(Order) << std::endl;
+    std::cout << std::setw(30) << "  Element Type:" << utils::demangle(typeid(T).name()) << std::endl;
+    std::cout << std::setw(30) << "  Nonzeros:" << nnz() << std::endl;
+    std::cout << std::setw(30) << "  Index deltas:" << bits_ << " bits, " << n_escapes() << " escapes" << std::endl;
+    std::cout << std::setw(30) << "  Memory usage (bytes):" << weight() << " (plain indices: " << plain_weight() << ")" << std::endl;
+    std::cout << std::setw(30) << "  Compression ratio:" << compression_ratio() << " (indices only: " << index_compression_ratio() << ")" << std::endl;
+    std::cout << std::string(50, '*') << std::endl;
+}
+
+} // namespace algebra
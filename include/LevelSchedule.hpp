@@ -0,0 +1,64 @@
+#ifndef LEVELSCHEDULE_HPP
+#define LEVELSCHEDULE_HPP
+
+#include <vector>
+#include <limits>
+
+namespace algebra {
+
+/**
+ * @brief Level-set analysis of a triangular part of a compressed matrix.
+ * 
+ * Stores the strict triangle row by row (whatever the storage order of the matrix), the position of
+ * the diagonal entries, and the rows grouped by level: a row belongs to level l if the longest chain
+ * of dependencies leading to it has length l. All the rows of a level depend only on rows of previous
+ * levels, so they can be solved in parallel.
+ * 
+ * Entries are referred to by their position in the values array of the matrix, so the schedule stays
+ * valid when the values change but the structure does not (e.g. after Matrix::refill()).
+ */
+struct LevelSchedule {
+    /**
+     * @brief Value of diag_pos for rows without a stored diagonal entry.
+     */
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief Start of each row of the strict triangle in index/pos.
+     */
+    std::vector<size_t> ptr;
+
+    /**
+     * @brief Column index of each entry of the strict triangle.
+     */
+    std::vector<size_t> index;
+
+    /**
+     * @brief Position in the values array of each entry of the strict triangle.
+     */
+    std::vector<size_t> pos;
+
+    /**
+     * @brief Position in the values array of the diagonal entry of each row.
+     */
+    std::vector<size_t> diag_pos;
+
+    /**
+     * @brief Start of each level in level_rows.
+     */
+    std::vector<size_t> level_ptr;
+
+    /**
+     * @brief Rows grouped by level (increasing row index inside each level).
+     */
+    std::vector<size_t> level_rows;
+
+    /**
+     * @brief Returns the number of levels.
+     */
+    size_t n_levels() const { return level_ptr.empty() ? 0 : level_ptr.size() - 1; }
+};
+
+} // namespace algebra
+
+#endif // LEVELSCHEDULE_HPP
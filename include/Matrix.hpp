@@ -12,6 +12,10 @@
 #include <unordered_map>
 #include <sstream>
 #include <string>
+#include <memory>
+#include <tuple>
+#include <atomic>
+#include <thread>
 
 // External libraries
 #include <omp.h> // for parallel computing (matrix * vector methods)
@@ -20,12 +24,19 @@
 // Project headers
 #include "StorageOrder.hpp"
 #include "CompressedMatrix.hpp"
+#include "SparsityPattern.hpp"
 #include "NormType.hpp"
+#include "TriangularPart.hpp"
+#include "LevelSchedule.hpp"
 #include "Utils.hpp"
 #include "Parameters.hpp"
 
 namespace algebra {
 
+template<typename U> class DistributedMatrix; // see DistributedMatrix.hpp (MPI builds only)
+template<typename U, StorageOrder O> class MatrixVectorProduct; // see Expression.hpp
+template<typename U, StorageOrder O> class IndexCompressedMatrix; // see IndexCompressedMatrix.hpp
+
 /**
  * @brief A sparse matrix class with optional compression.
  * 
@@ -40,6 +51,10 @@ namespace algebra {
 template<typename T, StorageOrder Order>
 class Matrix {
 
+    template<typename U> friend class DistributedMatrix; // reads the local rows when distributing a matrix
+    template<typename U, StorageOrder O> friend class MatrixVectorProduct; // evaluates fused expressions row by row
+    template<typename U, StorageOrder O> friend class IndexCompressedMatrix; // encodes and decodes the compressed arrays
+
 private:
     // 📦 MATRIX DATA CONTAINERS
 
@@ -47,7 +62,11 @@ private:
     size_t cols_; ///< Number of columns.
 
     std::map<std::array<size_t, 2>, T> sparse_data_; ///< Sparse dynamic storage: COOmap format.
-    CompressedMatrix<T> compressed_data_; ///< Compressed storage: CSR/CSC format.
+    CompressedMatrix<T> compressed_data_{Order}; ///< Compressed storage: CSR/CSC format.
+    std::shared_ptr<const SparsityPattern<Order>> pattern_; ///< Frozen sparsity pattern (set by freeze_pattern()/attach_pattern()).
+
+    mutable std::shared_ptr<const LevelSchedule> lower_schedule_; ///< Cached level-set analysis of the lower triangle.
+    mutable std::shared_ptr<const LevelSchedule> upper_schedule_; ///< Cached level-set analysis of the upper triangle.
 
     // 🔒 PRIVATE METHODS
 
@@ -77,6 +96,88 @@ private:
      */
     bool mm_stringstream_to_sparsedata_loader(const std::istringstream& iss_original);
 
+    /**
+     * @brief In-place inclusive prefix sum, parallelised by blocks for large inputs.
+     * 
+     * Each thread scans a contiguous block, then adds the sum of the preceding blocks.
+     * 
+     * @tparam IndexVector Vector of size_t (std::vector or std::pmr::vector).
+     * @param v Vector to scan.
+     */
+    template<typename IndexVector>
+    static void parallel_prefix_sum(IndexVector& v);
+
+    /**
+     * @brief Stable parallel counting sort of entries by bucket (row or column).
+     * 
+     * Builds a per-thread histogram of the buckets on contiguous chunks of the entries, turns it into
+     * bucket pointers with a blocked prefix sum, and computes the destination of every entry. All the steps
+     * run in the same parallel region, since the per-thread counts are only valid for the team that built them.
+     * The team is capped to n / n_buckets threads, so that the n_threads * n_buckets counters never outgrow the entries.
+     * Since each thread scatters its own chunk in order, the relative order of the entries inside a bucket is preserved.
+     * 
+     * @tparam BucketVector Vector of size_t (std::vector or std::pmr::vector).
+     * @tparam PtrVector Vector of size_t (std::vector or std::pmr::vector).
+     * @param bucket Bucket of each entry.
+     * @param n_buckets Number of buckets.
+     * @param ptr Output: bucket pointers (size n_buckets + 1).
+     * @param position Output: destination of each entry.
+     */
+    template<typename BucketVector, typename PtrVector>
+    static void parallel_bucket_positions(const BucketVector& bucket, size_t n_buckets, PtrVector& ptr, std::vector<size_t>& position);
+
+    /**
+     * @brief Drops everything derived from the current structure: the frozen pattern and the level schedules.
+     * 
+     * Called whenever the storage is replaced by a different structure.
+     */
+    void invalidate_structure();
+
+    /**
+     * @brief Checks whether the frozen pattern still describes the compressed storage (dimensions, outer_ptr, inner_index).
+     * 
+     * Used by compress() to keep the pattern and the schedules across a round trip that restores the same structure.
+     * 
+     * @return False if there is no pattern or the structure differs from it.
+     */
+    bool pattern_matches_storage() const;
+
+    /**
+     * @brief Checks that the frozen pattern describes the current compressed storage, before a refill.
+     * 
+     * @throws std::runtime_error if there is no frozen pattern, the matrix is not compressed, or the pattern is stale.
+     */
+    void check_pattern() const;
+
+    /**
+     * @brief Builds the level-set analysis of a triangular part of the compressed matrix.
+     * 
+     * @tparam Part Triangular part to analyse.
+     * @return The new schedule.
+     * @throws std::runtime_error if a diagonal entry is not stored.
+     */
+    template<TriangularPart Part>
+    std::shared_ptr<const LevelSchedule> build_level_schedule() const;
+
+    /**
+     * @brief Solves the triangular system described by a schedule.
+     * 
+     * Levels are processed one after the other, the rows of a level in parallel (one barrier per level).
+     * In the point-to-point variant there are no barriers: rows are processed in level order and each row
+     * only waits for the rows it depends on, signalled through per-row flags.
+     * 
+     * @param schedule Level-set analysis of the triangle.
+     * @param b Right-hand side.
+     * @param point_to_point Whether to use the point-to-point synchronisation.
+     * @return Solution vector.
+     */
+    std::vector<T> level_scheduled_solve(const LevelSchedule& schedule, const std::vector<T>& b, bool point_to_point) const;
+
+    /**
+     * @brief Computes b - S x, where S is the strict triangle described by a schedule.
+     */
+    std::vector<T> strict_triangle_residual(const LevelSchedule& schedule, const std::vector<T>& b, const std::vector<T>& x) const;
+
 public:
     // 🏗️ CONSTRUCTORS
 
@@ -117,6 +218,12 @@ public:
      * 
      * * Converts the matrix from uncompressed (Coo-MAP) format to compressed format (CSR for RowMajor, CSC for ColMajor).
      * It builds compressed_data_ from sparse_data_ and then clears the uncompressed storage to save memory.
+     * In CSR the (i, j) order of the COO map already is the compressed order: each thread walks the map read-only
+     * over its own range of rows (from lower_bound({row_lo, 0})), once to count the entries of its rows and, after a
+     * parallel prefix sum, once more to write them from outer_ptr[row_lo]. In CSC the map is traversed once, the entries
+     * are staged and placed with a parallel counting sort by column.
+     * With an arena allocation policy the outer sizes are counted first, so that the arena can be reserved and its
+     * pages first touched by the threads of the parallel product before being filled.
      */
     void compress();
 
@@ -125,10 +232,100 @@ public:
      * 
      * Converts the matrix from compressed form (CSR/CSC) to uncompressed form (Coo-MAP).
      * It reconstructs sparse_data_ using the compressed_data_ arrays and clears the compressed storage afterward.
+     * The map is bulk-built with hinted insertion at its end from entries already sorted by (i, j)
+     * (in CSC they are first reordered by row with a parallel counting sort), so each insertion is amortised O(1).
      * 
      */
     void decompress();
 
+    // 🧊 SYMBOLIC / NUMERIC SPLIT
+
+    /**
+     * @brief Freezes the current sparsity pattern of the matrix.
+     * 
+     * Compresses the matrix if needed and builds a SparsityPattern (outer_ptr, inner_index) from the
+     * compressed storage. The index arrays are copied once into the pattern; the matrix then releases its
+     * own arrays and reads the shared ones. The returned pattern can be attached to other
+     * matrices with the same structure, and the values can then be refilled without rebuilding the
+     * COO map and recompressing.
+     * 
+     * @return Shared pointer to the frozen pattern.
+     */
+    std::shared_ptr<const SparsityPattern<Order>> freeze_pattern();
+
+    /**
+     * @brief Adopts a frozen sparsity pattern, discarding the current content.
+     * 
+     * The matrix takes the dimensions and the compressed structure of the pattern; all values are set to zero.
+     * The index arrays are not copied: the compressed storage reads the immutable arrays of the pattern, so
+     * N matrices on one pattern store the indices once and only their N value arrays. Only the values follow
+     * the allocation policy of the matrix (arena and first-touch placement); a later write to the structure
+     * (e.g. compress() of a different structure) gives the matrix its own index arrays again.
+     * 
+     * @param pattern Pattern to adopt (usually obtained from freeze_pattern() on another matrix).
+     */
+    void attach_pattern(std::shared_ptr<const SparsityPattern<Order>> pattern);
+
+    /**
+     * @brief Refills the values of a matrix with a frozen pattern from a triplet stream.
+     * 
+     * All values are reset to zero, then every triplet (i, j, value) is accumulated into its slot
+     * (duplicates are summed, as in finite element assembly). Slots are resolved in parallel by binary
+     * search in the pattern (see SparsityPattern::slot()); the scatter is parallelised by giving each thread ownership of a
+     * contiguous range of slots, so no atomics are needed. The triplets are first bucketed by owner range
+     * (stable counting sort), so each range only visits its own triplets.
+     * 
+     * @param triplets Entries (i, j, value) to accumulate.
+     * @return True if all triplets belong to the pattern, false otherwise (values are left untouched).
+     * @throws std::runtime_error if there is no frozen pattern or it no longer describes the storage (see check_pattern()).
+     */
+    bool refill(const std::vector<std::tuple<size_t, size_t, T>>& triplets);
+
+    /**
+     * @brief Refills the values of a matrix with a frozen pattern through element assembly.
+     * 
+     * All values are reset to zero, then kernel(e, local) is called for every element of the plan:
+     * it must fill the dense row-major local block `local` (already sized and zeroed) of element e,
+     * which is then accumulated into the precomputed slots. Elements of the same color share no dof,
+     * so each color is assembled in parallel with a per-thread local buffer and no atomics.
+     * 
+     * @tparam Kernel Callable with signature void(size_t e, std::vector<T>& local).
+     * @param plan Assembly plan built on the pattern of this matrix (or on a pattern with the same structure).
+     * @param kernel Element kernel.
+     * @throws std::runtime_error if there is no frozen pattern or it no longer describes the storage (see check_pattern()).
+     * @throws std::invalid_argument if the plan was built on a different structure.
+     */
+    template<typename Kernel>
+    void refill(const ElementAssemblyPlan<Order>& plan, Kernel&& kernel);
+
+    /**
+     * @brief Returns the frozen sparsity pattern, or nullptr if the pattern is not frozen.
+     * 
+     * The pattern is dropped by the calls that replace the structure: attach_pattern() (replaced by the new one),
+     * mm_load_mtx(), and compress() when the new compressed arrays differ from the pattern (e.g. after update(),
+     * resize() or transpose() of a non-symmetric structure). A decompress()/compress() round trip that restores
+     * the same structure keeps it; refill() requires the matrix to be compressed.
+     */
+    std::shared_ptr<const SparsityPattern<Order>> pattern() const;
+
+    // 🧠 MEMORY
+
+    /**
+     * @brief Sets the allocation policy of the compressed arrays.
+     * 
+     * With an arena policy outer_ptr, inner_index and values are stored in one contiguous, 64-byte aligned block,
+     * optionally backed by huge pages, which is reused across compress/decompress cycles. If the matrix is compressed,
+     * its arrays are moved to the new storage.
+     * 
+     * @param policy New allocation policy.
+     */
+    void set_allocation_policy(AllocationPolicy policy);
+
+    /**
+     * @brief Returns the allocation policy of the compressed arrays.
+     */
+    AllocationPolicy allocation_policy() const;
+
     /**
      * @brief Resizes the matrix to new dimensions.
      * 
@@ -169,6 +366,19 @@ public:
      */
     std::vector<T> product_by_vector(const std::vector<T>& v) const;
 
+    /**
+     * @brief Multiplies the (possibly uncompressed) matrix by a vector serially, writing into a caller-provided vector.
+     * 
+     * The output is resized to the number of rows and its capacity is reused, so repeated products allocate nothing.
+     * The product is always serial: it is meant for callers that already run several products in parallel
+     * (e.g. BatchExecutor).
+     * 
+     * @param v Input vector.
+     * @param output Output vector (must not be v, which is read while output is written).
+     * @throws std::invalid_argument if the vector size does not match the columns, or if output is v.
+     */
+    void product_by_vector(const std::vector<T>& v, std::vector<T>& output) const;
+
     /**
      * @brief Overloads the * operator to perform matrix-vector multiplication when rhs is a column vector matrix.
      * 
@@ -200,14 +410,57 @@ public:
      * @brief Computes a matrix norm.
      * 
      * Computes the matrix norm (One, Infinity, or Frobenius) depending on the template parameter.
-     * Handles both compressed (CSR/CSC) and uncompressed (COOmap) storage formats, with automatic transposition if needed.
+     * Handles both compressed (CSR/CSC) and uncompressed (COOmap) storage formats without modifying the storage
+     * (in particular, the frozen pattern and the cached schedules are kept).
      * Returns a scalar value representing the computed norm.
      * 
      * @tparam norm_type Type of norm to compute.
      * @return Computed norm value.
      */
     template<NormType norm_type>
-    T norm();
+    T norm() const;
+
+    // 🔺 TRIANGULAR SOLVES
+
+    /**
+     * @brief Returns the level-set analysis of a triangular part of the matrix.
+     * 
+     * The analysis is computed at the first call and cached; it is discarded together with the frozen
+     * pattern when the structure of the matrix changes (see pattern()), and by any compress() if no pattern
+     * is frozen, but not when only the values change (refill()). The first call is not thread-safe.
+     * 
+     * @tparam Part Triangular part (Lower or Upper).
+     * @return The cached schedule.
+     * @throws std::runtime_error if the matrix is not compressed or a diagonal entry is not stored.
+     */
+    template<TriangularPart Part>
+    const LevelSchedule& analyse_triangular() const;
+
+    /**
+     * @brief Solves the triangular system T x = b, where T is the lower or upper triangle (diagonal included) of the matrix.
+     * 
+     * Entries outside the chosen triangle are ignored. Works on both CSR and CSC matrices; the rows of each
+     * level of the cached schedule are solved in parallel with OpenMP.
+     * 
+     * @tparam Part Triangular part (Lower or Upper).
+     * @param b Right-hand side.
+     * @param point_to_point If true, replaces the per-level barriers with point-to-point waits on the rows each row depends on.
+     * @return Solution vector.
+     */
+    template<TriangularPart Part>
+    std::vector<T> triangular_solve(const std::vector<T>& b, bool point_to_point = false) const;
+
+    /**
+     * @brief Performs symmetric Gauss-Seidel sweeps on A x = b.
+     * 
+     * Each sweep is a forward sweep (D + L) x = b - U x followed by a backward sweep (D + U) x = b - L x,
+     * both done with the level-scheduled triangular solves, so the result is the same as the sequential sweep.
+     * 
+     * @param b Right-hand side.
+     * @param x Initial guess, overwritten with the result.
+     * @param sweeps Number of symmetric sweeps.
+     */
+    void symmetric_gauss_seidel(const std::vector<T>& b, std::vector<T>& x, size_t sweeps = 1) const;
 
     // MATRIX MARKET PARSER + LOADER METHODS
 
@@ -266,6 +519,13 @@ public:
      * @return An array {rows, cols}.
      */
     std::array<size_t, 2> size() const;
+
+    /**
+     * @brief Returns the number of stored entries.
+     * 
+     * @return Size of the values array if compressed, number of map entries otherwise.
+     */
+    size_t nnz() const;
 };
 
 } // namespace algebra
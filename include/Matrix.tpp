@@ -51,45 +51,104 @@ template<typename T, StorageOrder Order>
 void Matrix<T, Order>::compress() {
 // Converts the matrix from uncompressed (Coo-MAP) format to compressed format (CSR for RowMajor, CSC for ColMajor).
 // It builds compressed_data_ from sparse_data_ and then clears the uncompressed storage to save memory.
+// CSR: each thread walks the map (read-only) over its own range of rows, starting from lower_bound({row_lo, 0}).
+// CSC: the map is traversed once into flat arrays, then sorted by column with a parallel counting sort.
 
     // Determine the conversion type
     constexpr bool isRowMajor = (Order == StorageOrder::RowMajor);
     size_t outer_size = isRowMajor ? rows_ : cols_;
+    size_t nnz = sparse_data_.size();  // total number of non zero values
+    const bool parallel = nnz >= params::NNZ_PARALLELIZATION_LIMIT;
+
+    if constexpr (isRowMajor) {
+        // 1. Parallel histogram: each thread counts the entries of its rows
+        std::vector<size_t> row_ptr(outer_size + 1, 0);
+        #pragma omp parallel if(parallel)
+        {
+            const size_t n_threads = omp_get_num_threads();
+            const size_t thread_id = omp_get_thread_num();
+            const size_t row_lo = outer_size * thread_id / n_threads;
+            const size_t row_hi = outer_size * (thread_id + 1) / n_threads;
+
+            for (auto it = sparse_data_.lower_bound({row_lo, 0}); it != sparse_data_.end() && it->first[0] < row_hi; ++it) {
+                row_ptr[it->first[0] + 1]++;
+            }
+        }
 
-    // Clears the values and preparation
-    compressed_data_.values.clear();
-    compressed_data_.inner_index.clear();
-    compressed_data_.outer_ptr.assign(outer_size + 1, 0);  // initialise outer_ptr with zeroes
-
-    // 1. Counts the values in each row/column
-    for (const auto& [key, val] : sparse_data_) {
-        size_t outer = isRowMajor ? key[0] : key[1];  // if CSR uses the row as outer if CSC uses the column  
-        compressed_data_.outer_ptr[outer + 1]++;   // to know how many elements are in each column/row
-    }                                
-
-    // 2. Indicates where starts each row
-    for (size_t i = 1; i <= outer_size; ++i) {  // outer_ptr[i]   -> index of starting of the i-th row/column in the vector values  
-                                                // outer_ptr[i+1] -> index excluded of the next row
-        compressed_data_.outer_ptr[i] += compressed_data_.outer_ptr[i - 1];
-    }
+        // 2. Indicates where starts each row (parallel prefix sum)
+        parallel_prefix_sum(row_ptr);
 
-    // 3. Allocates space and to not call pushback each time 
-    size_t nnz = sparse_data_.size();  // total number of non zero values 
-    compressed_data_.values.resize(nnz);
-    compressed_data_.inner_index.resize(nnz);
-    std::vector<size_t> temp_offset = compressed_data_.outer_ptr;
+        if (compressed_data_.arena) {
+            compressed_data_.reserve(row_ptr); // placement-aware allocation (see CompressedMatrix::reserve)
+        }
+        compressed_data_.values.resize(nnz);
+        compressed_data_.inner_index.resize(nnz);
+        compressed_data_.outer_ptr.assign(row_ptr.begin(), row_ptr.end());
+
+        // 3. Parallel scatter: the map is sorted by (i, j), which already is the CSR order,
+        //    so each thread writes its rows sequentially from outer_ptr[row_lo]
+        size_t* inner_index = compressed_data_.inner_index.mutable_data();
+        #pragma omp parallel if(parallel)
+        {
+            const size_t n_threads = omp_get_num_threads();
+            const size_t thread_id = omp_get_thread_num();
+            const size_t row_lo = outer_size * thread_id / n_threads;
+            const size_t row_hi = outer_size * (thread_id + 1) / n_threads;
+
+            size_t idx = compressed_data_.outer_ptr[row_lo];
+            for (auto it = sparse_data_.lower_bound({row_lo, 0}); it != sparse_data_.end() && it->first[0] < row_hi; ++it) {
+                compressed_data_.values[idx] = it->second;
+                inner_index[idx] = it->first[1];
+                ++idx;
+            }
+        }
+    } else {
+        if (compressed_data_.arena) {
+            // Placement-aware allocation: count the column sizes first, then reserve the arena and first touch it
+            // with the schedule of the parallel product (see CompressedMatrix::reserve)
+            std::vector<size_t> counts(outer_size + 1, 0);
+            for (const auto& [key, val] : sparse_data_) {
+                counts[key[1] + 1]++;
+            }
+            parallel_prefix_sum(counts);
+            compressed_data_.reserve(counts);
+        }
+        compressed_data_.values.resize(nnz);
+        compressed_data_.inner_index.resize(nnz);
 
-    // 4. Giving values to the vectors
-    for (const auto& [key, val] : sparse_data_) {
-        size_t outer = isRowMajor ? key[0] : key[1];
-        size_t inner = isRowMajor ? key[1] : key[0];
-        size_t idx = temp_offset[outer]++;
+        // 1. Single pass: stage the entries (in (i, j) order) into flat arrays
+        std::vector<size_t> rows(nnz), cols(nnz);
+        std::vector<T> vals(nnz);
+        size_t idx = 0;
+        for (const auto& [key, val] : sparse_data_) {
+            rows[idx] = key[0];
+            cols[idx] = key[1];
+            vals[idx] = val;
+            ++idx;
+        }
 
-        compressed_data_.values[idx] = val;
-        compressed_data_.inner_index[idx] = inner;
+        // 2. Parallel histogram + prefix sum by column, stable: rows stay sorted inside each column
+        std::vector<size_t> col_ptr, position;
+        parallel_bucket_positions(cols, outer_size, col_ptr, position);
+        compressed_data_.outer_ptr.assign(col_ptr.begin(), col_ptr.end());
+
+        // 3. Parallel scatter
+        size_t* inner_index = compressed_data_.inner_index.mutable_data();
+        #pragma omp parallel for if(parallel)
+        for (size_t k = 0; k < nnz; ++k) {
+            compressed_data_.values[position[k]] = vals[k];
+            inner_index[position[k]] = rows[k];
+        }
     }
 
     sparse_data_.clear();
+    if (pattern_matches_storage()) {
+        // Same structure as the frozen pattern: read its index arrays again instead of keeping a copy
+        compressed_data_.outer_ptr.share(pattern_->shared_outer_ptr());
+        compressed_data_.inner_index.share(pattern_->shared_inner_index());
+    } else {
+        invalidate_structure(); // the structure has changed: the pattern and the schedules no longer describe it
+    }
 
 }
 
@@ -97,80 +156,403 @@ template<typename T, StorageOrder Order>
 void Matrix<T, Order>::decompress() {
 // Converts the matrix from compressed form (CSR/CSC) to uncompressed form (Coo-MAP).
 // It reconstructs sparse_data_ using the compressed_data_ arrays and clears the compressed storage afterward.
+// Entries are inserted in increasing (i, j) order with a hint at the end of the map (amortised O(1) per insertion).
 
     sparse_data_.clear();
 
+    if (compressed_data_.outer_ptr.empty()) {
+        return; // nothing to decompress
+    }
+
     constexpr bool isRowMajor = (Order == StorageOrder::RowMajor);
     size_t outer_size = compressed_data_.outer_ptr.size() - 1;
+    size_t nnz = compressed_data_.values.size();
 
-    for (size_t outer = 0; outer < outer_size; ++outer) {
-        for (size_t k = compressed_data_.outer_ptr[outer]; k < compressed_data_.outer_ptr[outer + 1]; ++k) {
-            size_t inner = compressed_data_.inner_index[k];
+    if constexpr (isRowMajor) {
+        // CSR order already is the map order
+        for (size_t i = 0; i < outer_size; ++i) {
+            for (size_t k = compressed_data_.outer_ptr[i]; k < compressed_data_.outer_ptr[i + 1]; ++k) {
+                if (compressed_data_.values[k] != T(0)) { // explicit zeros are dropped, as update() does
+                    sparse_data_.emplace_hint(sparse_data_.end(), std::array<size_t, 2>{i, compressed_data_.inner_index[k]}, compressed_data_.values[k]);
+                }
+            }
+        }
+    } else {
+        // 1. Column of each entry
+        const bool parallel = nnz >= params::NNZ_PARALLELIZATION_LIMIT;
+        std::vector<size_t> cols(nnz);
+        #pragma omp parallel for if(parallel) schedule(dynamic, 256)
+        for (size_t j = 0; j < outer_size; ++j) {
+            for (size_t k = compressed_data_.outer_ptr[j]; k < compressed_data_.outer_ptr[j + 1]; ++k) {
+                cols[k] = j;
+            }
+        }
+
+        // 2. Stable parallel counting sort by row: columns stay sorted inside each row
+        std::vector<size_t> row_ptr, position;
+        parallel_bucket_positions(compressed_data_.inner_index, rows_, row_ptr, position);
+
+        std::vector<size_t> sorted_cols(nnz);
+        std::vector<T> sorted_vals(nnz);
+        #pragma omp parallel for if(parallel)
+        for (size_t k = 0; k < nnz; ++k) {
+            sorted_cols[position[k]] = cols[k];
+            sorted_vals[position[k]] = compressed_data_.values[k];
+        }
 
-            size_t i = isRowMajor ? outer : inner;
-            size_t j = isRowMajor ? inner : outer;
+        // 3. Hinted insertion in (i, j) order
+        for (size_t i = 0; i < rows_; ++i) {
+            for (size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+                if (sorted_vals[k] != T(0)) {
+                    sparse_data_.emplace_hint(sparse_data_.end(), std::array<size_t, 2>{i, sorted_cols[k]}, sorted_vals[k]);
+                }
+            }
+        }
+    }
+
+    compressed_data_.clear(); // the pattern and the schedules are kept: compress() checks them against the new structure
+}
 
-            update(i, j, compressed_data_.values[k]);  // utilizzo del metodo update()
+template<typename T, StorageOrder Order>
+template<typename IndexVector>
+void Matrix<T, Order>::parallel_prefix_sum(IndexVector& v) {
+// In-place inclusive prefix sum: each thread scans its own block, then adds the total of the previous blocks.
+
+    const size_t n = v.size();
+    if (n < params::NNZ_PARALLELIZATION_LIMIT) {
+        for (size_t i = 1; i < n; ++i) {
+            v[i] += v[i - 1];
         }
+        return;
     }
 
-    compressed_data_.clear();
+    std::vector<size_t> block_sum(omp_get_max_threads() + 1, 0);
+    #pragma omp parallel
+    {
+        const size_t n_threads = omp_get_num_threads();
+        const size_t thread_id = omp_get_thread_num();
+        const size_t lo = n * thread_id / n_threads;
+        const size_t hi = n * (thread_id + 1) / n_threads;
+
+        // 1. Local scan of the block
+        for (size_t i = lo + 1; i < hi; ++i) {
+            v[i] += v[i - 1];
+        }
+        block_sum[thread_id + 1] = (hi > lo) ? v[hi - 1] : 0;
+        #pragma omp barrier
+
+        // 2. Offset of the block
+        size_t offset = 0;
+        for (size_t t = 1; t <= thread_id; ++t) {
+            offset += block_sum[t];
+        }
+        for (size_t i = lo; i < hi; ++i) {
+            v[i] += offset;
+        }
+    }
+}
+
+template<typename T, StorageOrder Order>
+template<typename BucketVector, typename PtrVector>
+void Matrix<T, Order>::parallel_bucket_positions(const BucketVector& bucket, size_t n_buckets, PtrVector& ptr, std::vector<size_t>& position) {
+// Stable counting sort of the entries by bucket, in a single parallel region (the per-thread counts and chunks
+// are only valid for the team that built them):
+// 1. each thread builds the histogram of a contiguous chunk of entries;
+// 2. the per-thread counts become per-thread starting offsets inside each bucket, the totals become bucket sizes;
+// 3. blocked prefix sum of the bucket sizes into bucket pointers (as in parallel_prefix_sum);
+// 4. each thread computes the destination of its chunk in order (this keeps the sort stable).
+// The histograms cost n_threads * n_buckets counters: the team is capped so that they never exceed the n entries
+// being sorted (many buckets and few entries, e.g. a hypersparse matrix, fall back to a single thread).
+
+    const size_t n = bucket.size();
+    ptr.assign(n_buckets + 1, 0);
+    position.resize(n);
+
+    const size_t max_team = std::min<size_t>(omp_get_max_threads(), n / std::max<size_t>(n_buckets, 1));
+    const int team = static_cast<int>(std::max<size_t>(max_team, 1));
+
+    std::vector<std::vector<size_t>> counts;
+    std::vector<size_t> block_sum;
+
+    #pragma omp parallel if(n >= params::NNZ_PARALLELIZATION_LIMIT && team > 1) num_threads(team)
+    {
+        const size_t n_threads = omp_get_num_threads();
+        const size_t thread_id = omp_get_thread_num();
+        const size_t lo = n * thread_id / n_threads;
+        const size_t hi = n * (thread_id + 1) / n_threads;
+
+        #pragma omp single
+        {
+            counts.resize(n_threads);
+            block_sum.assign(n_threads + 1, 0);
+        } // implicit barrier
+
+        // 1. Per-thread histogram
+        counts[thread_id].assign(n_buckets, 0);
+        for (size_t k = lo; k < hi; ++k) {
+            counts[thread_id][bucket[k]]++;
+        }
+        #pragma omp barrier
+
+        // 2. Per-thread offsets inside each bucket and bucket sizes
+        #pragma omp for
+        for (size_t b = 0; b < n_buckets; ++b) {
+            size_t running = 0;
+            for (size_t t = 0; t < n_threads; ++t) {
+                size_t c = counts[t][b];
+                counts[t][b] = running;
+                running += c;
+            }
+            ptr[b + 1] = running;
+        } // implicit barrier
+
+        // 3. Bucket pointers: local scan of a block of ptr, then offset by the total of the previous blocks
+        const size_t p_lo = (n_buckets + 1) * thread_id / n_threads;
+        const size_t p_hi = (n_buckets + 1) * (thread_id + 1) / n_threads;
+        for (size_t b = p_lo + 1; b < p_hi; ++b) {
+            ptr[b] += ptr[b - 1];
+        }
+        block_sum[thread_id + 1] = (p_hi > p_lo) ? ptr[p_hi - 1] : 0;
+        #pragma omp barrier
+
+        size_t offset = 0;
+        for (size_t t = 1; t <= thread_id; ++t) {
+            offset += block_sum[t];
+        }
+        for (size_t b = p_lo; b < p_hi; ++b) {
+            ptr[b] += offset;
+        }
+        #pragma omp barrier
+
+        // 4. Destinations
+        for (size_t k = lo; k < hi; ++k) {
+            size_t b = bucket[k];
+            position[k] = ptr[b] + counts[thread_id][b]++;
+        }
+    }
+}
+
+template<typename T, StorageOrder Order>
+void Matrix<T, Order>::invalidate_structure() {
+    pattern_.reset();
+    lower_schedule_.reset();
+    upper_schedule_.reset();
+}
+
+template<typename T, StorageOrder Order>
+bool Matrix<T, Order>::pattern_matches_storage() const {
+// The schedules are only kept alongside a pattern, which is the reference used to detect a structural change.
+
+    if (!pattern_ || pattern_->rows() != rows_ || pattern_->cols() != cols_) {
+        return false;
+    }
+    if (compressed_data_.outer_ptr.shared() == pattern_->shared_outer_ptr()
+        && compressed_data_.inner_index.shared() == pattern_->shared_inner_index()) {
+        return true; // still reading the arrays of the pattern
+    }
+    return std::equal(compressed_data_.outer_ptr.begin(), compressed_data_.outer_ptr.end(),
+                      pattern_->outer_ptr().begin(), pattern_->outer_ptr().end())
+        && std::equal(compressed_data_.inner_index.begin(), compressed_data_.inner_index.end(),
+                      pattern_->inner_index().begin(), pattern_->inner_index().end());
+}
+
+template<typename T, StorageOrder Order>
+void Matrix<T, Order>::check_pattern() const {
+// A pattern is usable only if it still describes the compressed arrays (same dimensions and number of slots).
+
+    if (!pattern_) {
+        throw std::runtime_error("No frozen sparsity pattern: call freeze_pattern() or attach_pattern() first.");
+    }
+    if (!is_compressed()) {
+        throw std::runtime_error("The matrix is not compressed: call compress() before refilling its frozen pattern.");
+    }
+    if (pattern_->nnz() != compressed_data_.values.size()
+        || pattern_->rows() != rows_ || pattern_->cols() != cols_) {
+        throw std::runtime_error("Stale sparsity pattern: the storage of the matrix has changed since it was frozen.");
+    }
+}
+
+// 🧊 SYMBOLIC / NUMERIC SPLIT
+template<typename T, StorageOrder Order>
+std::shared_ptr<const SparsityPattern<Order>> Matrix<T, Order>::freeze_pattern() {
+// Compresses the matrix if needed and copies the index arrays of the compressed storage into a SparsityPattern.
+// The matrix then releases its own arrays and reads the (shared) arrays of the pattern, which it keeps until the structure changes.
+
+    if (!is_compressed()) {
+        compress();
+    }
+    if (!pattern_) {
+        pattern_ = std::make_shared<const SparsityPattern<Order>>(rows_, cols_,
+            std::vector<size_t>(compressed_data_.outer_ptr.begin(), compressed_data_.outer_ptr.end()),
+            std::vector<size_t>(compressed_data_.inner_index.begin(), compressed_data_.inner_index.end()));
+        compressed_data_.outer_ptr.share(pattern_->shared_outer_ptr()); // releases the own copy
+        compressed_data_.inner_index.share(pattern_->shared_inner_index());
+    }
+    return pattern_;
+}
+
+template<typename T, StorageOrder Order>
+void Matrix<T, Order>::attach_pattern(std::shared_ptr<const SparsityPattern<Order>> pattern) {
+// Adopts the dimensions and the compressed structure of a frozen pattern; all values are set to zero.
+// The index arrays of the pattern are read in place, only the values are allocated.
+
+    sparse_data_.clear();
+    rows_ = pattern->rows();
+    cols_ = pattern->cols();
+
+    compressed_data_.share_indices(pattern->shared_outer_ptr(), pattern->shared_inner_index());
+
+    invalidate_structure();
+    pattern_ = std::move(pattern);
+}
+
+template<typename T, StorageOrder Order>
+bool Matrix<T, Order>::refill(const std::vector<std::tuple<size_t, size_t, T>>& triplets) {
+// Resets the values and accumulates the triplets into their slots (duplicates are summed).
+// 1. slots are resolved in parallel by binary search in the pattern (read-only lookups);
+// 2. the slots are split into contiguous owner ranges, and the triplets are bucketed by owner range with the
+//    stable counting sort of compress() (the order of duplicates is kept, so the sums are deterministic);
+// 3. each owner range is reset and accumulates its own bucket of triplets (no atomics, O(n_triplets) total work).
+// Returns false, leaving the values untouched, if a triplet is not part of the pattern.
+
+    check_pattern();
+
+    const size_t n_triplets = triplets.size();
+    const size_t nnz = compressed_data_.values.size();
+    const bool parallel = std::max(n_triplets, nnz) >= params::NNZ_PARALLELIZATION_LIMIT;
+
+    // 1. Resolve slots
+    std::vector<size_t> slots(n_triplets);
+    bool all_found = true;
+    #pragma omp parallel for if(parallel) reduction(&&:all_found)
+    for (size_t k = 0; k < n_triplets; ++k) {
+        slots[k] = pattern_->slot(std::get<0>(triplets[k]), std::get<1>(triplets[k]));
+        all_found = all_found && (slots[k] != SparsityPattern<Order>::npos);
+    }
+    if (!all_found) {
+        return false;
+    }
+
+    // 2. Bucket the triplets by owner range: range r owns the slots [nnz * r / n_ranges, nnz * (r + 1) / n_ranges)
+    const size_t n_ranges = parallel ? std::max<size_t>(1, std::min<size_t>(omp_get_max_threads(), nnz)) : 1;
+    std::vector<size_t> owner(n_triplets);
+    #pragma omp parallel for if(parallel)
+    for (size_t k = 0; k < n_triplets; ++k) {
+        owner[k] = ((slots[k] + 1) * n_ranges - 1) / nnz; // largest r such that nnz * r / n_ranges <= slot
+    }
+
+    std::vector<size_t> range_ptr, position;
+    parallel_bucket_positions(owner, n_ranges, range_ptr, position);
+
+    std::vector<size_t> sorted_slots(n_triplets);
+    std::vector<T> sorted_values(n_triplets);
+    #pragma omp parallel for if(parallel)
+    for (size_t k = 0; k < n_triplets; ++k) {
+        sorted_slots[position[k]] = slots[k];
+        sorted_values[position[k]] = std::get<2>(triplets[k]);
+    }
+
+    // 3. Owner-computes scatter: each range only visits its own triplets
+    #pragma omp parallel for if(parallel) schedule(dynamic, 1)
+    for (size_t r = 0; r < n_ranges; ++r) {
+        const size_t lo = nnz * r / n_ranges;
+        const size_t hi = nnz * (r + 1) / n_ranges;
+
+        std::fill(compressed_data_.values.begin() + lo, compressed_data_.values.begin() + hi, T(0));
+        for (size_t p = range_ptr[r]; p < range_ptr[r + 1]; ++p) {
+            compressed_data_.values[sorted_slots[p]] += sorted_values[p];
+        }
+    }
+
+    return true;
+}
+
+template<typename T, StorageOrder Order>
+template<typename Kernel>
+void Matrix<T, Order>::refill(const ElementAssemblyPlan<Order>& plan, Kernel&& kernel) {
+// Resets the values and assembles every element of the plan, color by color.
+// Elements of the same color share no dof, hence write to disjoint slots: each color is a parallel loop
+// with a per-thread local block buffer and a plain (non-atomic) scatter.
+
+    check_pattern();
+    if (plan.pattern() != pattern_ && !plan.pattern()->same_structure(*pattern_)) {
+        throw std::invalid_argument("Assembly plan does not match the sparsity pattern of the matrix.");
+    }
+
+    const bool parallel = compressed_data_.values.size() >= params::NNZ_PARALLELIZATION_LIMIT;
+
+    #pragma omp parallel if(parallel)
+    {
+        #pragma omp for schedule(static)
+        for (size_t k = 0; k < compressed_data_.values.size(); ++k) {
+            compressed_data_.values[k] = T(0);
+        }
+
+        std::vector<T> local; // per-thread local block
+        const auto& color_ptr = plan.color_ptr();
+        const auto& color_elements = plan.color_elements();
+
+        for (size_t c = 0; c < plan.n_colors(); ++c) {
+            #pragma omp for schedule(dynamic, 64)
+            for (size_t k = color_ptr[c]; k < color_ptr[c + 1]; ++k) {
+                size_t e = color_elements[k];
+                size_t n = plan.element_size(e);
+                local.assign(n * n, T(0));
+                kernel(e, local);
+
+                const size_t* slots = plan.element_slots(e);
+                for (size_t a = 0; a < n * n; ++a) {
+                    compressed_data_.values[slots[a]] += local[a];
+                }
+            }
+            // implicit barrier: next color starts after this one is complete
+        }
+    }
+}
+
+template<typename T, StorageOrder Order>
+std::shared_ptr<const SparsityPattern<Order>> Matrix<T, Order>::pattern() const {
+    return pattern_;
 }
 
 template<typename T, StorageOrder Order>
 template<NormType norm_type>
-T Matrix<T, Order>::norm() {
+T Matrix<T, Order>::norm() const {
 // Computes the matrix norm (One, Infinity, or Frobenius) depending on the template parameter.
-// Handles both compressed (CSR/CSC) and uncompressed (COOmap) storage formats, with automatic transposition if needed.
+// Handles both compressed (CSR/CSC) and uncompressed (COOmap) storage formats without modifying the storage.
 // Returns a scalar value representing the computed norm.
     
     T norm = T(0);
     if (is_compressed()){
-        // Compressed case - CSR/CSC
-        
-        bool was_transposed = false;
-        if constexpr (norm_type == NormType::One) {
-            if constexpr (Order == StorageOrder::RowMajor){
-                transpose();
-                was_transposed=true;
-            }
-            for (size_t j = 0; j < cols_; ++j) {
-                T col_sum = T(0);
-                for (size_t idx = compressed_data_.outer_ptr[j]; idx < compressed_data_.outer_ptr[j+1]; ++idx) {
-                    col_sum += std::abs(compressed_data_.values[idx]);
+        // Compressed case - CSR/CSC, read-only: the sums along the inner dimension are scattered into a vector
+        // instead of transposing the matrix (which would recompress it and drop its frozen pattern)
+        constexpr bool isRowMajor = (Order == StorageOrder::RowMajor);
+        const size_t outer_size = isRowMajor ? rows_ : cols_;
+
+        if constexpr (norm_type == NormType::One || norm_type == NormType::Infinity) {
+            // One: column sums (outer in CSC, inner in CSR); Infinity: row sums (outer in CSR, inner in CSC)
+            constexpr bool by_outer = (norm_type == NormType::One) != isRowMajor;
+            std::vector<T> sums(by_outer ? 0 : (isRowMajor ? cols_ : rows_), T(0));
+            for (size_t o = 0; o < outer_size; ++o) {
+                T outer_sum = T(0);
+                for (size_t idx = compressed_data_.outer_ptr[o]; idx < compressed_data_.outer_ptr[o+1]; ++idx) {
+                    if constexpr (by_outer) {
+                        outer_sum += std::abs(compressed_data_.values[idx]);
+                    } else {
+                        sums[compressed_data_.inner_index[idx]] += std::abs(compressed_data_.values[idx]);
+                    }
                 }
-                if (std::abs(col_sum) > std::abs(norm)) {norm = col_sum;}
+                if (by_outer && std::abs(outer_sum) > std::abs(norm)) {norm = outer_sum;}
             }
-            if(was_transposed){transpose();}
-            return norm;
-            
-        } else if constexpr (norm_type == NormType::Infinity) {
-            if constexpr (Order == StorageOrder::ColumnMajor){
-                transpose();
-                was_transposed=true;
-            }
-            for (size_t j = 0; j < cols_; ++j) {
-                T row_sum = T(0);
-                for (size_t idx = compressed_data_.outer_ptr[j]; idx < compressed_data_.outer_ptr[j+1]; ++idx) {
-                    row_sum += std::abs(compressed_data_.values[idx]);
-                }
-                if (std::abs(row_sum) > std::abs(norm)) {norm = row_sum;}
+            for (const auto& sum : sums) {
+                if (std::abs(sum) > std::abs(norm)) {norm = sum;}
             }
-            if(was_transposed){transpose();}
             return norm;
+
         } else if constexpr (norm_type == NormType::Frobenius) {
-            if constexpr (Order == StorageOrder::ColumnMajor){
-                transpose();
-                was_transposed=true;
-            }
-            for (size_t j = 0; j < cols_; ++j) {
-                T row_sum = T(0);
-                for (size_t idx = compressed_data_.outer_ptr[j]; idx < compressed_data_.outer_ptr[j+1]; ++idx) {
-                    row_sum += std::pow(std::abs(compressed_data_.values[idx]),T(2));
-                }
-                norm += row_sum;
+            for (const auto& value : compressed_data_.values) {
+                norm += std::pow(std::abs(value), T(2));
             }
-            if(was_transposed){transpose();}
             return std::sqrt(norm);
         }
     }
@@ -207,6 +589,203 @@ T Matrix<T, Order>::norm() {
     
 }
 
+// 🔺 TRIANGULAR SOLVES
+template<typename T, StorageOrder Order>
+template<TriangularPart Part>
+std::shared_ptr<const LevelSchedule> Matrix<T, Order>::build_level_schedule() const {
+// Extracts the strict triangle row by row (from CSR or CSC), locates the diagonal,
+// and groups the rows by level: level(i) = 1 + max level(j) over the entries (i, j) of the strict triangle.
+
+    constexpr bool isRowMajor = (Order == StorageOrder::RowMajor);
+    constexpr bool isLower = (Part == TriangularPart::Lower);
+    const size_t n = rows_;
+    const size_t outer_size = compressed_data_.outer_ptr.size() - 1;
+    auto in_triangle = [](size_t i, size_t j) { return isLower ? j < i : j > i; };
+
+    auto schedule = std::make_shared<LevelSchedule>();
+    schedule->ptr.assign(n + 1, 0);
+    schedule->diag_pos.assign(n, LevelSchedule::npos);
+
+    // 1. Count the strict entries of each row and find the diagonal
+    for (size_t outer = 0; outer < outer_size; ++outer) {
+        for (size_t k = compressed_data_.outer_ptr[outer]; k < compressed_data_.outer_ptr[outer + 1]; ++k) {
+            size_t i = isRowMajor ? outer : compressed_data_.inner_index[k];
+            size_t j = isRowMajor ? compressed_data_.inner_index[k] : outer;
+            if (i == j) {
+                schedule->diag_pos[i] = k;
+            } else if (in_triangle(i, j)) {
+                schedule->ptr[i + 1]++;
+            }
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (schedule->diag_pos[i] == LevelSchedule::npos) {
+            throw std::runtime_error("Triangular solve: missing diagonal entry in row " + std::to_string(i) + ".");
+        }
+        schedule->ptr[i + 1] += schedule->ptr[i];
+    }
+
+    // 2. Strict triangle in row-wise order (columns stay sorted since the outer loop visits them in order in CSC)
+    schedule->index.resize(schedule->ptr[n]);
+    schedule->pos.resize(schedule->ptr[n]);
+    std::vector<size_t> temp_offset(schedule->ptr.begin(), schedule->ptr.end() - 1);
+    for (size_t outer = 0; outer < outer_size; ++outer) {
+        for (size_t k = compressed_data_.outer_ptr[outer]; k < compressed_data_.outer_ptr[outer + 1]; ++k) {
+            size_t i = isRowMajor ? outer : compressed_data_.inner_index[k];
+            size_t j = isRowMajor ? compressed_data_.inner_index[k] : outer;
+            if (i != j && in_triangle(i, j)) {
+                size_t idx = temp_offset[i]++;
+                schedule->index[idx] = j;
+                schedule->pos[idx] = k;
+            }
+        }
+    }
+
+    // 3. Levels: rows are visited in dependency order (increasing for Lower, decreasing for Upper)
+    std::vector<size_t> level(n, 0);
+    size_t n_levels = 0;
+    for (size_t r = 0; r < n; ++r) {
+        size_t i = isLower ? r : n - 1 - r;
+        for (size_t k = schedule->ptr[i]; k < schedule->ptr[i + 1]; ++k) {
+            level[i] = std::max(level[i], level[schedule->index[k]] + 1);
+        }
+        n_levels = std::max(n_levels, level[i] + 1);
+    }
+
+    // 4. Group rows by level (counting sort)
+    schedule->level_ptr.assign(n_levels + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        schedule->level_ptr[level[i] + 1]++;
+    }
+    for (size_t l = 1; l <= n_levels; ++l) {
+        schedule->level_ptr[l] += schedule->level_ptr[l - 1];
+    }
+    schedule->level_rows.resize(n);
+    temp_offset.assign(schedule->level_ptr.begin(), schedule->level_ptr.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        schedule->level_rows[temp_offset[level[i]]++] = i;
+    }
+
+    return schedule;
+}
+
+template<typename T, StorageOrder Order>
+template<TriangularPart Part>
+const LevelSchedule& Matrix<T, Order>::analyse_triangular() const {
+// Returns the cached level-set analysis of the requested triangle, building it at the first call.
+
+    if (!is_compressed()) {
+        throw std::runtime_error("Triangular solves require a compressed matrix.");
+    }
+    if (rows_ != cols_) {
+        throw std::invalid_argument("Triangular solves require a square matrix.");
+    }
+
+    auto& schedule = (Part == TriangularPart::Lower) ? lower_schedule_ : upper_schedule_;
+    if (!schedule) {
+        schedule = build_level_schedule<Part>();
+    }
+    return *schedule;
+}
+
+template<typename T, StorageOrder Order>
+std::vector<T> Matrix<T, Order>::level_scheduled_solve(const LevelSchedule& schedule, const std::vector<T>& b, bool point_to_point) const {
+// Solves the triangular system row by row following the level order of the schedule.
+// Level variant: one parallel loop (and one barrier) per level.
+// Point-to-point variant: a single parallel loop over the rows in level order; every row spins only on the flags of the rows
+// it depends on. Deadlock-free because each thread processes its iterations in increasing order and dependencies always come first.
+
+    const size_t n = rows_;
+    const auto& values = compressed_data_.values;
+    std::vector<T> x(n, T(0));
+
+    auto solve_row = [&](size_t i) {
+        T sum = b[i];
+        for (size_t k = schedule.ptr[i]; k < schedule.ptr[i + 1]; ++k) {
+            sum -= values[schedule.pos[k]] * x[schedule.index[k]];
+        }
+        x[i] = sum / values[schedule.diag_pos[i]];
+    };
+
+    const bool parallel = n >= params::NROWS_PARALLELIZATON_LIMIT;
+
+    if (!point_to_point) {
+        #pragma omp parallel if(parallel)
+        for (size_t l = 0; l < schedule.n_levels(); ++l) {
+            #pragma omp for schedule(static)
+            for (size_t p = schedule.level_ptr[l]; p < schedule.level_ptr[l + 1]; ++p) {
+                solve_row(schedule.level_rows[p]);
+            }
+            // implicit barrier: the next level starts when this one is done
+        }
+    } else {
+        std::unique_ptr<std::atomic<bool>[]> done(new std::atomic<bool>[n]);
+        for (size_t i = 0; i < n; ++i) {
+            done[i].store(false, std::memory_order_relaxed);
+        }
+
+        #pragma omp parallel for if(parallel) schedule(static, 16)
+        for (size_t p = 0; p < n; ++p) {
+            size_t i = schedule.level_rows[p];
+            for (size_t k = schedule.ptr[i]; k < schedule.ptr[i + 1]; ++k) {
+                while (!done[schedule.index[k]].load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+            }
+            solve_row(i);
+            done[i].store(true, std::memory_order_release);
+        }
+    }
+
+    return x;
+}
+
+template<typename T, StorageOrder Order>
+std::vector<T> Matrix<T, Order>::strict_triangle_residual(const LevelSchedule& schedule, const std::vector<T>& b, const std::vector<T>& x) const {
+// Computes b - S x row by row, where S is the strict triangle stored in the schedule.
+
+    const size_t n = rows_;
+    std::vector<T> r(n);
+
+    #pragma omp parallel for if(n >= params::NROWS_PARALLELIZATON_LIMIT)
+    for (size_t i = 0; i < n; ++i) {
+        T sum = b[i];
+        for (size_t k = schedule.ptr[i]; k < schedule.ptr[i + 1]; ++k) {
+            sum -= compressed_data_.values[schedule.pos[k]] * x[schedule.index[k]];
+        }
+        r[i] = sum;
+    }
+    return r;
+}
+
+template<typename T, StorageOrder Order>
+template<TriangularPart Part>
+std::vector<T> Matrix<T, Order>::triangular_solve(const std::vector<T>& b, bool point_to_point) const {
+// Solves T x = b with T the lower or upper triangle (diagonal included), using the cached level schedule.
+
+    const LevelSchedule& schedule = analyse_triangular<Part>();
+    if (b.size() != rows_) {
+        throw std::invalid_argument("Right-hand side size does not match the matrix.");
+    }
+    return level_scheduled_solve(schedule, b, point_to_point);
+}
+
+template<typename T, StorageOrder Order>
+void Matrix<T, Order>::symmetric_gauss_seidel(const std::vector<T>& b, std::vector<T>& x, size_t sweeps) const {
+// Symmetric Gauss-Seidel: forward sweep (D + L) x = b - U x, then backward sweep (D + U) x = b - L x.
+
+    const LevelSchedule& lower = analyse_triangular<TriangularPart::Lower>();
+    const LevelSchedule& upper = analyse_triangular<TriangularPart::Upper>();
+    if (b.size() != rows_ || x.size() != cols_) {
+        throw std::invalid_argument("Vector sizes do not match the matrix.");
+    }
+
+    for (size_t s = 0; s < sweeps; ++s) {
+        x = level_scheduled_solve(lower, strict_triangle_residual(upper, b, x), false);
+        x = level_scheduled_solve(upper, strict_triangle_residual(lower, b, x), false);
+    }
+}
+
 template<typename T, StorageOrder Order>
 void Matrix<T, Order>::transpose() {
 // Transposes the matrix in-place by swapping rows and columns.
@@ -338,6 +917,44 @@ std::vector<T> Matrix<T, Order>::product_by_vector(const std::vector<T>& v) cons
 
 }
 
+template<typename T, StorageOrder Order>
+void Matrix<T, Order>::product_by_vector(const std::vector<T>& v, std::vector<T>& output) const {
+// Serial product written directly into output (no allocation once output has enough capacity).
+
+    if (v.size() != cols_) {
+        throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+    }
+    if (&v == &output) {
+        throw std::invalid_argument("The output vector of a product must be distinct from the input vector.");
+    }
+
+    if (!is_compressed()) {
+        // Uncompressed multiplication (COO)
+        output.assign(rows_, T(0));
+        for (const auto& [key, val] : sparse_data_) {
+            output[key[0]] += val * v[key[1]];
+        }
+    } else if constexpr (Order == StorageOrder::RowMajor) {
+        // RowMajor (CSR): traverse row by row
+        output.resize(rows_);
+        for (size_t i = 0; i < rows_; ++i) {
+            T sum = 0;
+            for (size_t k = compressed_data_.outer_ptr[i]; k < compressed_data_.outer_ptr[i + 1]; ++k) {
+                sum += compressed_data_.values[k] * v[compressed_data_.inner_index[k]];
+            }
+            output[i] = sum;
+        }
+    } else {
+        // ColumnMajor (CSC): traverse column by column
+        output.assign(rows_, T(0));
+        for (size_t j = 0; j < cols_; ++j) {
+            for (size_t k = compressed_data_.outer_ptr[j]; k < compressed_data_.outer_ptr[j + 1]; ++k) {
+                output[compressed_data_.inner_index[k]] += compressed_data_.values[k] * v[j];
+            }
+        }
+    }
+}
+
 template<typename T, StorageOrder Order> // This function applies to any Matrix type with any storage order
 std::vector<T> Matrix<T, Order>::operator*(const Matrix<T, Order>& rhs) const {// The result is a plain std::vector<T>, representing the product result
 // Overloads the * operator to perform matrix-vector multiplication when rhs is a column vector matrix.
@@ -447,6 +1064,7 @@ bool Matrix<T, Order>::mm_load_mtx(const std::string& filename){
     if (filename.ends_with(".mtx.gz")) {
         sparse_data_.clear(); // clear sparse_data_ values
         compressed_data_.clear(); // clear compressed data values
+        invalidate_structure(); // the pattern and schedules described the old content
 
         auto file_content = mm_extract_gz(filename);
         std::istringstream iss(file_content);
@@ -455,6 +1073,7 @@ bool Matrix<T, Order>::mm_load_mtx(const std::string& filename){
     else if (filename.ends_with(".mtx")) {
         sparse_data_.clear(); // clear sparse_data_ values
         compressed_data_.clear(); // clear compressed data values
+        invalidate_structure(); // the pattern and schedules described the old content
 
         std::ifstream ifs(filename);
         if (!ifs.is_open()) {
@@ -475,6 +1094,17 @@ bool Matrix<T, Order>::mm_load_mtx(const std::string& filename){
     
 }
     
+template<typename T, StorageOrder Order>
+void Matrix<T, Order>::set_allocation_policy(AllocationPolicy policy) {
+// Moves the compressed arrays (if any) into storage allocated with the new policy.
+    compressed_data_.set_policy(policy);
+}
+
+template<typename T, StorageOrder Order>
+AllocationPolicy Matrix<T, Order>::allocation_policy() const {
+    return compressed_data_.policy;
+}
+
 template<typename T, StorageOrder Order>
 void Matrix<T, Order>::resize(size_t new_rows, size_t new_cols) {
 // Resizes the matrix to new_rows x new_cols, updating internal dimensions.
@@ -679,6 +1309,11 @@ void Matrix<T, Order>::info() const {
     std::cout << std::setw(30) << "  Element Type:" << utils::demangle(typeid(T).name()) << std::endl;
     std::cout << std::setw(30) << "  Compression status:" << (is_compressed() ? "Compressed" : "Uncompressed") << std::endl;
     std::cout << std::setw(30) << "  Memory usage (bytes):" << weight() << std::endl;
+    std::cout << std::setw(30) << "  Allocation policy:" << allocationPolicyToString(compressed_data_.policy);
+    if (compressed_data_.arena && compressed_data_.arena->capacity() > 0) {
+        std::cout << " (" << compressed_data_.arena->pages() << ")";
+    }
+    std::cout << std::endl;
     std::cout << std::string(50, '*') << std::endl;
 }
 
@@ -687,6 +1322,11 @@ std::array<size_t, 2>  Matrix<T,Order>::size() const {
     return {rows_, cols_};
 }
 
+template<typename T, StorageOrder Order>
+size_t Matrix<T, Order>::nnz() const {
+    return is_compressed() ? compressed_data_.values.size() : sparse_data_.size();
+}
+
 // ✝️ GRAVEYARD : DEPRECATED FUNCTIONS
 // ashes have been scattered, nothing to see here
 
@@ -25,6 +25,30 @@ const int NROWS_PARALLELIZATON_LIMIT = 1000;
  */
 const int NCOLS_PARALLELIZATON_LIMIT = 1000;
 
+/**
+ * @brief Nonzero threshold for enabling parallelization of passes over the stored entries.
+ * 
+ * When the number of stored entries exceeds this limit, loops over the values array
+ * (e.g. refilling the values of a frozen pattern) are parallelized.
+ */
+const size_t NNZ_PARALLELIZATION_LIMIT = 10000;
+
+/**
+ * @brief Nonzero threshold above which a job of a batch of products is a "large" job.
+ * 
+ * Large jobs are multiplied one at a time with all threads (intra-matrix parallelism), smaller ones
+ * are spread over the threads of the batch executor (inter-matrix parallelism).
+ */
+const size_t BATCH_LARGE_JOB_NNZ = 100000;
+
+/**
+ * @brief Number of rows evaluated together by the fused expression templates.
+ * 
+ * Every term of an expression is accumulated into one block of the destination before moving to the next block,
+ * so the block stays in the L1 cache while each term runs its own row kernel.
+ */
+constexpr size_t EXPRESSION_BLOCK_SIZE = 256;
+
 /**
  * @brief Size of the buffer used in file operations.
  * 
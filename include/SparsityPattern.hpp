@@ -0,0 +1,183 @@
+#ifndef SPARSITYPATTERN_HPP
+#define SPARSITYPATTERN_HPP
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "StorageOrder.hpp"
+
+namespace algebra {
+
+/**
+ * @brief Frozen (symbolic) sparsity pattern of a compressed matrix.
+ *
+ * @tparam Order Storage order (RowMajor for CSR, ColumnMajor for CSC).
+ *
+ * Holds the `outer_ptr` and `inner_index` arrays of a compressed matrix. The slot of (i, j), i.e. the
+ * position of the entry inside the `values` array, is found by binary search in the sorted inner indices
+ * of its row (CSR) or column (CSC), so the pattern costs no memory beyond the index arrays themselves.
+ * The pattern does not depend on the element type, so it can be shared (through a std::shared_ptr)
+ * between several Matrix objects holding different values, e.g. a mass and a stiffness matrix
+ * assembled on the same mesh. The index arrays are immutable and held through shared pointers: the
+ * matrices attached to the pattern read them in place (see Matrix::attach_pattern()) and only store their values.
+ */
+template<StorageOrder Order>
+class SparsityPattern {
+
+private:
+    size_t rows_; ///< Number of rows.
+    size_t cols_; ///< Number of columns.
+
+    std::shared_ptr<const std::vector<size_t>> outer_ptr_;   ///< Row (CSR) or column (CSC) pointers.
+    std::shared_ptr<const std::vector<size_t>> inner_index_; ///< Column (CSR) or row (CSC) indices, sorted in each row (column).
+
+public:
+    /**
+     * @brief Value returned by slot() when (i, j) is not part of the pattern.
+     */
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief Builds the pattern from compressed index arrays.
+     *
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @param outer_ptr Row (CSR) or column (CSC) pointers.
+     * @param inner_index Column (CSR) or row (CSC) indices, sorted inside each row (column) as compress() produces them.
+     */
+    SparsityPattern(size_t rows, size_t cols, std::vector<size_t> outer_ptr, std::vector<size_t> inner_index);
+
+    /**
+     * @brief Returns the position of entry (i, j) in the values array.
+     *
+     * @param i Row index.
+     * @param j Column index.
+     * @return Slot of (i, j), or npos if the entry is not part of the pattern.
+     */
+    size_t slot(size_t i, size_t j) const;
+
+    /**
+     * @brief Whether another pattern describes the same structure (dimensions, outer pointers and inner indices).
+     */
+    bool same_structure(const SparsityPattern& other) const;
+
+    /**
+     * @brief Returns the number of rows.
+     */
+    size_t rows() const { return rows_; }
+
+    /**
+     * @brief Returns the number of columns.
+     */
+    size_t cols() const { return cols_; }
+
+    /**
+     * @brief Returns the number of stored entries.
+     */
+    size_t nnz() const { return inner_index_->size(); }
+
+    /**
+     * @brief Returns the row (CSR) or column (CSC) pointers.
+     */
+    const std::vector<size_t>& outer_ptr() const { return *outer_ptr_; }
+
+    /**
+     * @brief Returns the column (CSR) or row (CSC) indices.
+     */
+    const std::vector<size_t>& inner_index() const { return *inner_index_; }
+
+    /**
+     * @brief Returns the shared row (CSR) or column (CSC) pointers, for the matrices reading them in place.
+     */
+    const std::shared_ptr<const std::vector<size_t>>& shared_outer_ptr() const { return outer_ptr_; }
+
+    /**
+     * @brief Returns the shared column (CSR) or row (CSC) indices, for the matrices reading them in place.
+     */
+    const std::shared_ptr<const std::vector<size_t>>& shared_inner_index() const { return inner_index_; }
+};
+
+/**
+ * @brief Precomputed plan for refilling matrix values through element assembly.
+ *
+ * @tparam Order Storage order of the matrices the plan applies to.
+ *
+ * Each element is described by the list of its degrees of freedom (dofs) and contributes a dense
+ * local block over dofs x dofs. The plan stores, for every element, the slots its local block is
+ * scattered into, and a greedy coloring of the elements such that no two elements of the same color
+ * share a dof. Elements of one color therefore write to disjoint rows (and columns), so they can be
+ * assembled in parallel without atomics.
+ */
+template<StorageOrder Order>
+class ElementAssemblyPlan {
+
+private:
+    std::shared_ptr<const SparsityPattern<Order>> pattern_; ///< Pattern the slots refer to.
+
+    std::vector<size_t> element_ptr_;   ///< Start of each element in element_dofs_.
+    std::vector<size_t> element_dofs_;  ///< Flattened element connectivity.
+    std::vector<size_t> slot_ptr_;      ///< Start of each element's local block in element_slots_.
+    std::vector<size_t> element_slots_; ///< Flattened row-major local block -> slot map.
+
+    std::vector<size_t> color_ptr_;      ///< Start of each color in color_elements_.
+    std::vector<size_t> color_elements_; ///< Elements grouped by color.
+
+public:
+    /**
+     * @brief Builds the element -> slot map and the element coloring.
+     *
+     * @param pattern Pattern of the matrices that will be refilled (must be square).
+     * @param elements Connectivity: the dofs of each element.
+     * @throws std::invalid_argument if an element block is not contained in the pattern.
+     */
+    ElementAssemblyPlan(std::shared_ptr<const SparsityPattern<Order>> pattern, const std::vector<std::vector<size_t>>& elements);
+
+    /**
+     * @brief Returns the pattern the plan was built for.
+     */
+    const std::shared_ptr<const SparsityPattern<Order>>& pattern() const { return pattern_; }
+
+    /**
+     * @brief Returns the number of elements.
+     */
+    size_t n_elements() const { return element_ptr_.size() - 1; }
+
+    /**
+     * @brief Returns the number of colors.
+     */
+    size_t n_colors() const { return color_ptr_.size() - 1; }
+
+    /**
+     * @brief Returns the number of dofs of element e.
+     */
+    size_t element_size(size_t e) const { return element_ptr_[e + 1] - element_ptr_[e]; }
+
+    /**
+     * @brief Returns a pointer to the dofs of element e.
+     */
+    const size_t* element_dofs(size_t e) const { return element_dofs_.data() + element_ptr_[e]; }
+
+    /**
+     * @brief Returns a pointer to the row-major slots of the local block of element e.
+     */
+    const size_t* element_slots(size_t e) const { return element_slots_.data() + slot_ptr_[e]; }
+
+    /**
+     * @brief Returns the color pointers (elements of color c are color_elements()[color_ptr()[c] .. color_ptr()[c+1]]).
+     */
+    const std::vector<size_t>& color_ptr() const { return color_ptr_; }
+
+    /**
+     * @brief Returns the elements grouped by color.
+     */
+    const std::vector<size_t>& color_elements() const { return color_elements_; }
+};
+
+} // namespace algebra
+
+#include "SparsityPattern.tpp" // methods implementation
+
+#endif // SPARSITYPATTERN_HPP
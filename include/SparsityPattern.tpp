@@ -0,0 +1,122 @@
+/* This .tpp file contains the implementation of the SparsityPattern and ElementAssemblyPlan class templates.
+They implement the symbolic part of the symbolic/numeric split: the slot lookup of a frozen pattern
+and the element coloring used to refill matrix values in parallel without atomics.
+ */
+#include "SparsityPattern.hpp"
+
+namespace algebra{
+
+// SPARSITY PATTERN
+template<StorageOrder Order>
+SparsityPattern<Order>::SparsityPattern(size_t rows, size_t cols, std::vector<size_t> outer_ptr, std::vector<size_t> inner_index)
+    : rows_(rows), cols_(cols),
+      outer_ptr_(std::make_shared<const std::vector<size_t>>(std::move(outer_ptr))),
+      inner_index_(std::make_shared<const std::vector<size_t>>(std::move(inner_index))) {}
+
+template<StorageOrder Order>
+size_t SparsityPattern<Order>::slot(size_t i, size_t j) const {
+// Returns the position of (i, j) in the values array, or npos if it is not part of the pattern.
+// Binary search of the inner index in the (sorted) segment of the outer index.
+
+    if (i >= rows_ || j >= cols_) {
+        return npos;
+    }
+    constexpr bool isRowMajor = (Order == StorageOrder::RowMajor);
+    const size_t outer = isRowMajor ? i : j;
+    const size_t inner = isRowMajor ? j : i;
+
+    const auto first = inner_index_->begin() + (*outer_ptr_)[outer];
+    const auto last = inner_index_->begin() + (*outer_ptr_)[outer + 1];
+    const auto it = std::lower_bound(first, last, inner);
+    return (it != last && *it == inner) ? static_cast<size_t>(it - inner_index_->begin()) : npos;
+}
+
+template<StorageOrder Order>
+bool SparsityPattern<Order>::same_structure(const SparsityPattern& other) const {
+    if (this == &other) {
+        return true;
+    }
+    if (rows_ != other.rows_ || cols_ != other.cols_) {
+        return false;
+    }
+    return (outer_ptr_ == other.outer_ptr_ || *outer_ptr_ == *other.outer_ptr_)
+        && (inner_index_ == other.inner_index_ || *inner_index_ == *other.inner_index_);
+}
+
+// ELEMENT ASSEMBLY PLAN
+template<StorageOrder Order>
+ElementAssemblyPlan<Order>::ElementAssemblyPlan(std::shared_ptr<const SparsityPattern<Order>> pattern, const std::vector<std::vector<size_t>>& elements)
+    : pattern_(std::move(pattern)) {
+// Flattens the connectivity, resolves the slots of every local block once,
+// and greedily colors the elements so that elements of the same color share no dof.
+
+    if (pattern_->rows() != pattern_->cols()) {
+        throw std::invalid_argument("Element assembly requires a square sparsity pattern.");
+    }
+
+    size_t n_elements = elements.size();
+    element_ptr_.assign(n_elements + 1, 0);
+    slot_ptr_.assign(n_elements + 1, 0);
+    for (size_t e = 0; e < n_elements; ++e) {
+        element_ptr_[e + 1] = element_ptr_[e] + elements[e].size();
+        slot_ptr_[e + 1] = slot_ptr_[e] + elements[e].size() * elements[e].size();
+    }
+
+    // 1. Connectivity and local block -> slot map
+    element_dofs_.resize(element_ptr_[n_elements]);
+    element_slots_.resize(slot_ptr_[n_elements]);
+    for (size_t e = 0; e < n_elements; ++e) {
+        const auto& dofs = elements[e];
+        std::copy(dofs.begin(), dofs.end(), element_dofs_.begin() + element_ptr_[e]);
+
+        size_t* slots = element_slots_.data() + slot_ptr_[e];
+        for (size_t a = 0; a < dofs.size(); ++a) {
+            for (size_t b = 0; b < dofs.size(); ++b) {
+                size_t s = pattern_->slot(dofs[a], dofs[b]);
+                if (s == SparsityPattern<Order>::npos) {
+                    throw std::invalid_argument("Element block is not contained in the sparsity pattern.");
+                }
+                slots[a * dofs.size() + b] = s;
+            }
+        }
+    }
+
+    // 2. Greedy coloring: an element takes the smallest color not used by any element sharing one of its dofs
+    std::vector<std::vector<size_t>> dof_colors(pattern_->rows());
+    std::vector<size_t> element_color(n_elements, 0);
+    std::vector<bool> forbidden;
+    size_t n_colors = 0;
+
+    for (size_t e = 0; e < n_elements; ++e) {
+        forbidden.assign(n_colors + 1, false);
+        for (size_t d : elements[e]) {
+            for (size_t c : dof_colors[d]) {
+                forbidden[c] = true;
+            }
+        }
+        size_t color = 0;
+        while (forbidden[color]) { ++color; }
+
+        element_color[e] = color;
+        n_colors = std::max(n_colors, color + 1);
+        for (size_t d : elements[e]) {
+            dof_colors[d].push_back(color);
+        }
+    }
+
+    // 3. Group elements by color (counting sort, keeps the element order inside each color)
+    color_ptr_.assign(n_colors + 1, 0);
+    for (size_t e = 0; e < n_elements; ++e) {
+        color_ptr_[element_color[e] + 1]++;
+    }
+    for (size_t c = 1; c <= n_colors; ++c) {
+        color_ptr_[c] += color_ptr_[c - 1];
+    }
+    color_elements_.resize(n_elements);
+    std::vector<size_t> temp_offset = color_ptr_;
+    for (size_t e = 0; e < n_elements; ++e) {
+        color_elements_[temp_offset[element_color[e]]++] = e;
+    }
+}
+
+} // namespace algebra
@@ -10,6 +10,9 @@
 #include <numeric>
 
 #include "Matrix.hpp"
+#include "BatchExecutor.hpp"
+#include "Expression.hpp"
+#include "IndexCompressedMatrix.hpp"
 #include "Utils.hpp"
 
 using namespace utils;
@@ -206,6 +209,114 @@ namespace tests{
      * and uncompressed states. The diagonal values are printed for both states to show the difference.
      */
     void diagonal_view_test();
+    /**
+     * @brief Tests the symbolic/numeric split (frozen pattern + value refill).
+     * 
+     * This function assembles the stiffness matrix of a 1D finite element mesh, freezes its pattern,
+     * and checks that refilling the values from a triplet stream and from an element-assembly callback
+     * gives the same matrix as rebuilding it with update() and compress().
+     * 
+     * @details 
+     * The pattern is shared with a second matrix (a mass-like matrix with different values) to show
+     * that several matrices can hold different values on the same frozen structure. The time needed by
+     * a rebuild (update() + compress()) is compared with the time needed by the two refill paths over
+     * a number of "time steps".
+     * 
+     * @param n_elements Number of 1D elements (the matrix has n_elements + 1 rows).
+     * @param n_steps Number of simulated time steps.
+     */
+    void pattern_refill_test(size_t n_elements = 200000, size_t n_steps = 10);
+    /**
+     * @brief Benchmarks the throughput of compress() and decompress() against the number of threads.
+     * 
+     * Builds a random square sparse matrix with a fixed number of nonzeros per row, in both RowMajor and
+     * ColumnMajor order, and measures the time of compress() and decompress() for 1, 2, 4, ... threads
+     * up to omp_get_max_threads(). The throughput is reported in nonzeros per second.
+     * 
+     * @param size Number of rows (and columns) of the matrix.
+     * @param nnz_per_row Number of random nonzeros per row.
+     * @param repetitions Number of compress/decompress cycles averaged for each thread count.
+     * 
+     * @details
+     * Results are printed to the console and saved to "output/conversion_throughput.csv".
+     */
+    void conversion_throughput_speedtest(size_t size = 50000, size_t nnz_per_row = 20, size_t repetitions = 3);
+    /**
+     * @brief Tests the level-scheduled triangular solves and the symmetric Gauss-Seidel sweep.
+     * 
+     * Builds the 5-point Laplacian of a grid_size x grid_size grid (natural ordering, which gives
+     * 2 * grid_size - 1 levels), in both RowMajor and ColumnMajor order, and checks the lower and upper
+     * triangular solves against a known solution, for the level-synchronous and the point-to-point variants.
+     * 
+     * @details
+     * Right-hand sides are built by multiplying a random vector by matrices holding only the lower or upper
+     * triangle. The time of each solve is printed together with the number of levels and the error.
+     * Finally, a few symmetric Gauss-Seidel sweeps are applied to A x = b, printing the residual after each sweep.
+     * 
+     * @param grid_size Number of grid points per side.
+     */
+    void triangular_solve_test(size_t grid_size = 300);
+    /**
+     * @brief Compares the allocation policies of the compressed arrays.
+     * 
+     * Builds a random square sparse matrix in RowMajor order and, for every AllocationPolicy, compresses it and
+     * measures the average time of a matrix-vector product and of a decompress/compress cycle (which reuses the
+     * arena of the arena policies). Products are checked against the Default policy.
+     * 
+     * @param size Number of rows (and columns) of the matrix.
+     * @param nnz_per_row Number of random nonzeros per row.
+     * @param repetitions Number of products (and of conversion cycles, divided by 10) averaged for each policy.
+     * 
+     * @details
+     * Results are printed to the console and saved to "output/allocation_policy.csv".
+     */
+    void allocation_policy_speedtest(size_t size = 100000, size_t nnz_per_row = 10, size_t repetitions = 100);
+    /**
+     * @brief Benchmarks the batch executor against a loop of product_by_vector() calls.
+     * 
+     * Builds a batch of many small random CSR matrices (between min_rows and max_rows rows) plus a few large ones,
+     * and runs all the products both in a plain loop and with a BatchExecutor using omp_get_max_threads() workers.
+     * Throughput (jobs/s) and latency percentiles (time from the start of the batch to the end of a job) are
+     * reported for both, and the results of the executor are checked against the loop.
+     * 
+     * @param n_matrices Number of small matrices.
+     * @param min_rows Minimum number of rows of a small matrix.
+     * @param max_rows Maximum number of rows of a small matrix.
+     * @param n_large Number of large matrices (above the large job threshold).
+     * @param repetitions Number of batches averaged.
+     * 
+     * @details
+     * Results are printed to the console and saved to "output/batch_spmv.csv".
+     */
+    void batch_spmv_speedtest(size_t n_matrices = 2000, size_t min_rows = 100, size_t max_rows = 500, size_t n_large = 2, size_t repetitions = 5);
+    /**
+     * @brief Compares fused expression templates with products returning temporaries.
+     * 
+     * Evaluates y = A*x + B*z - alpha*w, with A and B random sparse matrices, both with separate product_by_vector()
+     * calls combined by a loop and with assign(y, A*x + B*z - alpha*w). This is done with two CSR matrices (fully
+     * fused row sweep) and with a CSR and a CSC matrix (row sweep + column scatter), checking that the results match.
+     * 
+     * @param size Number of rows (and columns) of the matrices.
+     * @param nnz_per_row Number of random nonzeros per row.
+     * @param repetitions Number of evaluations averaged.
+     */
+    void expression_template_test(size_t size = 200000, size_t nnz_per_row = 10, size_t repetitions = 20);
+    /**
+     * @brief Benchmarks the delta-encoded indices of IndexCompressedMatrix against plain size_t indices.
+     * 
+     * Encodes a Matrix Market matrix and the 5-point Laplacian of a grid_size x grid_size grid (both CSR),
+     * and for each prints the delta width, escapes, weights and compression ratio, and the time of the serial
+     * and parallel products with plain and encoded indices. Results of the encoded products and of decode()
+     * are checked against the plain matrix.
+     * 
+     * @param filename Path to the Matrix Market file.
+     * @param grid_size Side of the grid of the Laplacian.
+     * @param repetitions Minimum number of products averaged (small matrices use more).
+     * 
+     * @details
+     * Results are printed to the console and saved to "output/index_compression.csv".
+     */
+    void index_compression_speedtest(const std::string& filename = "./assets/lnsp_131.mtx", size_t grid_size = 1000, size_t repetitions = 50);
 
 }
 
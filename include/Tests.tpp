@@ -379,6 +379,648 @@ namespace tests{
         print(diag_compressed);
     }
 
+
+    void pattern_refill_test(size_t n_elements, size_t n_steps) {
+    // Assembles a 1D finite element stiffness matrix, freezes its pattern and compares
+    // a full rebuild (update() + compress()) with refills from triplets and from an element kernel.
+
+        std::cout << "\n=== Pattern Refill Test ===\n\n";
+
+        const size_t n = n_elements + 1;
+        using Clock = std::chrono::high_resolution_clock;
+
+        // Mesh connectivity: element e couples dofs e and e+1
+        std::vector<std::vector<size_t>> elements(n_elements);
+        for (size_t e = 0; e < n_elements; ++e) {
+            elements[e] = {e, e + 1};
+        }
+
+        // Stiffness triplets with a time-dependent coefficient
+        auto stiffness_triplets = [&](double coeff) {
+            std::vector<std::tuple<size_t, size_t, double>> triplets;
+            triplets.reserve(4 * n_elements);
+            for (size_t e = 0; e < n_elements; ++e) {
+                triplets.emplace_back(e, e, coeff);
+                triplets.emplace_back(e, e + 1, -coeff);
+                triplets.emplace_back(e + 1, e, -coeff);
+                triplets.emplace_back(e + 1, e + 1, coeff);
+            }
+            return triplets;
+        };
+
+        // Reference: rebuild through the COO map
+        auto rebuild = [&](Matrix<double, StorageOrder::RowMajor>& mat, double coeff) {
+            if (mat.is_compressed()) { mat.decompress(); }
+            for (size_t e = 0; e < n_elements; ++e) {
+                mat.update(e, e, (e == 0 ? coeff : 2 * coeff));
+                mat.update(e, e + 1, -coeff);
+                mat.update(e + 1, e, -coeff);
+            }
+            mat.update(n_elements, n_elements, coeff);
+            mat.compress();
+        };
+
+        Matrix<double, StorageOrder::RowMajor> reference(n, n);
+        rebuild(reference, 1.0);
+
+        Matrix<double, StorageOrder::RowMajor> stiffness(n, n);
+        rebuild(stiffness, 1.0);
+        auto pattern = stiffness.freeze_pattern();
+        ElementAssemblyPlan<StorageOrder::RowMajor> plan(pattern, elements);
+
+        // A second matrix sharing the same pattern, with different values
+        Matrix<double, StorageOrder::RowMajor> mass(0, 0);
+        mass.attach_pattern(pattern);
+        const double h = 1.0 / n_elements;
+        mass.refill(plan, [h](size_t, std::vector<double>& local) {
+            local = {2 * h / 6, h / 6, h / 6, 2 * h / 6};
+        });
+
+        std::cout << "Rows: " << n << ", nnz: " << pattern->nnz() << ", colors: " << plan.n_colors() << "\n";
+        std::cout << "Pattern shared by " << pattern.use_count() - 1 << " objects\n";
+        std::cout << "Index arrays read in place by " << pattern->shared_inner_index().use_count() - 1 << " matrices ("
+                  << (pattern->outer_ptr().size() + pattern->nnz()) * sizeof(size_t) / 1024 << " KiB stored once)\n\n";
+
+        std::vector<double> v = getRandomVector<double>(n);
+        auto max_diff = [](const std::vector<double>& a, const std::vector<double>& b) {
+            double diff = 0;
+            for (size_t i = 0; i < a.size(); ++i) { diff = std::max(diff, std::abs(a[i] - b[i])); }
+            return diff;
+        };
+
+        double time_rebuild = 0, time_triplets = 0, time_elements = 0;
+        double err_triplets = 0, err_elements = 0;
+        for (size_t step = 0; step < n_steps; ++step) {
+            const double coeff = 1.0 + 0.1 * step;
+
+            auto start = Clock::now();
+            rebuild(reference, coeff);
+            time_rebuild += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            auto expected = reference.product_by_vector(v);
+
+            auto triplets = stiffness_triplets(coeff);
+            start = Clock::now();
+            stiffness.refill(triplets);
+            time_triplets += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            err_triplets = std::max(err_triplets, max_diff(expected, stiffness.product_by_vector(v)));
+
+            start = Clock::now();
+            stiffness.refill(plan, [coeff](size_t, std::vector<double>& local) {
+                local = {coeff, -coeff, -coeff, coeff};
+            });
+            time_elements += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            err_elements = std::max(err_elements, max_diff(expected, stiffness.product_by_vector(v)));
+        }
+
+        // The mass matrix applied to a constant vector gives h at the interior nodes
+        auto mass_times_one = mass.product_by_vector(std::vector<double>(n, 1.0));
+
+        std::cout << std::left << std::setw(30) << "Method" << std::setw(20) << "Time/step (ms)" << "Max error\n";
+        std::cout << std::string(60, '-') << "\n";
+        std::cout << std::setw(30) << "update() + compress()" << std::setw(20) << time_rebuild / n_steps << "-\n";
+        std::cout << std::setw(30) << "refill (triplets)" << std::setw(20) << time_triplets / n_steps << err_triplets << "\n";
+        std::cout << std::setw(30) << "refill (element kernel)" << std::setw(20) << time_elements / n_steps << err_elements << "\n";
+        std::cout << "\nMass matrix row sum (interior node): " << mass_times_one[n / 2] << " (expected " << h << ")\n";
+        std::cout << "\n=== Done ===\n";
+    }
+
+    void conversion_throughput_speedtest(size_t size, size_t nnz_per_row, size_t repetitions) {
+    // Measures compress()/decompress() throughput (nnz/s) for increasing thread counts,
+    // for both storage orders, and checks that a compress/decompress round trip preserves the matrix.
+
+        std::cout << "=== Conversion Throughput Test ===\n\n";
+
+        std::ofstream file("output/conversion_throughput.csv");
+        file << "Order,Threads,Operation,TimeMs,NnzPerSecond\n";
+
+        const int max_threads = omp_get_max_threads();
+        std::vector<double> v = getRandomVector<double>(size);
+
+        auto run = [&]<StorageOrder Order>(Matrix<double, Order>& mat) {
+            const char* order = storageOrderToString(Order);
+
+            mat.compress();
+            auto expected = mat.product_by_vector(v);
+            const size_t nnz = mat.nnz();
+
+            std::cout << order << " (" << size << " x " << size << ", nnz = " << nnz << ")\n";
+            std::cout << std::left << std::setw(10) << "Threads"
+                    << std::setw(22) << "compress (Mnnz/s)"
+                    << std::setw(22) << "decompress (Mnnz/s)" << "\n";
+            std::cout << std::string(54, '-') << "\n";
+
+            for (int threads = 1; threads <= max_threads; threads = (threads == max_threads ? max_threads + 1 : std::min(2 * threads, max_threads))) {
+                omp_set_num_threads(threads);
+                double time_compress = 0, time_decompress = 0;
+
+                for (size_t r = 0; r < repetitions; ++r) {
+                    auto start = std::chrono::high_resolution_clock::now();
+                    mat.decompress();
+                    auto end = std::chrono::high_resolution_clock::now();
+                    time_decompress += std::chrono::duration<double, std::milli>(end - start).count();
+
+                    start = std::chrono::high_resolution_clock::now();
+                    mat.compress();
+                    end = std::chrono::high_resolution_clock::now();
+                    time_compress += std::chrono::duration<double, std::milli>(end - start).count();
+                }
+                time_compress /= repetitions;
+                time_decompress /= repetitions;
+
+                double rate_compress = nnz / (time_compress / 1000.0);
+                double rate_decompress = nnz / (time_decompress / 1000.0);
+                std::cout << std::left << std::setw(10) << threads
+                        << std::setw(22) << rate_compress / 1e6
+                        << std::setw(22) << rate_decompress / 1e6 << "\n";
+
+                file << order << "," << threads << ",compress," << time_compress << "," << rate_compress << "\n";
+                file << order << "," << threads << ",decompress," << time_decompress << "," << rate_decompress << "\n";
+            }
+            omp_set_num_threads(max_threads);
+
+            // Round trip check
+            auto result = mat.product_by_vector(v);
+            double diff = 0;
+            for (size_t i = 0; i < size; ++i) { diff = std::max(diff, std::abs(result[i] - expected[i])); }
+            std::cout << "Round trip max error: " << diff << "\n\n";
+        };
+
+        // Random matrix with nnz_per_row entries per row (plus the diagonal)
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<size_t> col_dist(0, size - 1);
+        std::uniform_real_distribution<double> val_dist(1.0, 9.0);
+
+        Matrix<double, StorageOrder::RowMajor> mat_row(size, size);
+        Matrix<double, StorageOrder::ColumnMajor> mat_col(size, size);
+        for (size_t i = 0; i < size; ++i) {
+            mat_row.update(i, i, 10.0);
+            mat_col.update(i, i, 10.0);
+            for (size_t k = 0; k < nnz_per_row; ++k) {
+                size_t j = col_dist(gen);
+                double value = val_dist(gen);
+                mat_row.update(i, j, value);
+                mat_col.update(i, j, value);
+            }
+        }
+
+        run(mat_row);
+        run(mat_col);
+
+        file.close();
+        std::cout << "=== Done. Results saved to conversion_throughput.csv ===\n";
+    }
+
+    void triangular_solve_test(size_t grid_size) {
+    // Checks the lower/upper triangular solves (level and point-to-point variants) on a 5-point Laplacian
+    // stored as CSR and CSC, and shows the residual reduction of symmetric Gauss-Seidel sweeps.
+
+        std::cout << "\n=== Triangular Solve Test ===\n\n";
+
+        const size_t n = grid_size * grid_size;
+        std::vector<double> x_true = getRandomVector<double>(n);
+
+        auto max_diff = [](const std::vector<double>& a, const std::vector<double>& b) {
+            double diff = 0;
+            for (size_t i = 0; i < a.size(); ++i) { diff = std::max(diff, std::abs(a[i] - b[i])); }
+            return diff;
+        };
+
+        auto run = [&]<StorageOrder Order>() {
+            // Full Laplacian and its two triangles
+            Matrix<double, Order> A(n, n), L(n, n), U(n, n);
+            for (size_t r = 0; r < grid_size; ++r) {
+                for (size_t c = 0; c < grid_size; ++c) {
+                    size_t i = r * grid_size + c;
+                    A.update(i, i, 4.0); L.update(i, i, 4.0); U.update(i, i, 4.0);
+                    std::array<std::array<long, 2>, 4> neighbours = {{{-1, 0}, {1, 0}, {0, -1}, {0, 1}}};
+                    for (const auto& [dr, dc] : neighbours) {
+                        long rr = long(r) + dr, cc = long(c) + dc;
+                        if (rr < 0 || cc < 0 || rr >= long(grid_size) || cc >= long(grid_size)) continue;
+                        size_t j = size_t(rr) * grid_size + size_t(cc);
+                        A.update(i, j, -1.0);
+                        (j < i ? L : U).update(i, j, -1.0);
+                    }
+                }
+            }
+            A.compress(); L.compress(); U.compress();
+
+            std::cout << storageOrderToString(Order) << " (n = " << n << ", levels: lower "
+                    << A.template analyse_triangular<TriangularPart::Lower>().n_levels() << ", upper "
+                    << A.template analyse_triangular<TriangularPart::Upper>().n_levels() << ")\n";
+            std::cout << std::left << std::setw(30) << "Solve" << std::setw(15) << "Time (ms)" << "Max error\n";
+            std::cout << std::string(55, '-') << "\n";
+
+            auto b_lower = L.product_by_vector(x_true);
+            auto b_upper = U.product_by_vector(x_true);
+            auto timed = [&](const std::string& label, auto&& solve) {
+                auto start = std::chrono::high_resolution_clock::now();
+                auto x = solve();
+                auto end = std::chrono::high_resolution_clock::now();
+                std::cout << std::setw(30) << label << std::setw(15)
+                        << std::chrono::duration<double, std::milli>(end - start).count()
+                        << max_diff(x, x_true) << "\n";
+            };
+            timed("lower (levels)", [&] { return A.template triangular_solve<TriangularPart::Lower>(b_lower); });
+            timed("lower (point-to-point)", [&] { return A.template triangular_solve<TriangularPart::Lower>(b_lower, true); });
+            timed("upper (levels)", [&] { return A.template triangular_solve<TriangularPart::Upper>(b_upper); });
+            timed("upper (point-to-point)", [&] { return A.template triangular_solve<TriangularPart::Upper>(b_upper, true); });
+
+            // Symmetric Gauss-Seidel on A x = b
+            auto b = A.product_by_vector(x_true);
+            std::vector<double> x(n, 0.0);
+            std::cout << "\nSymmetric Gauss-Seidel, max residual per sweep:";
+            for (size_t sweep = 0; sweep < 5; ++sweep) {
+                A.symmetric_gauss_seidel(b, x);
+                std::cout << " " << max_diff(A.product_by_vector(x), b);
+            }
+            std::cout << "\n\n";
+        };
+
+        run.template operator()<StorageOrder::RowMajor>();
+        run.template operator()<StorageOrder::ColumnMajor>();
+
+        std::cout << "=== Done ===\n";
+    }
+
+
+    void allocation_policy_speedtest(size_t size, size_t nnz_per_row, size_t repetitions) {
+    // Times the product and the decompress/compress cycle for every allocation policy
+    // and checks that all policies give the same product.
+
+        std::cout << "=== Allocation Policy Test ===\n\n";
+
+        std::ofstream file("output/allocation_policy.csv");
+        file << "Policy,ProductTimeMs,CycleTimeMs,MaxError\n";
+
+        // Random matrix with nnz_per_row entries per row (plus the diagonal)
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<size_t> col_dist(0, size - 1);
+        std::uniform_real_distribution<double> val_dist(1.0, 9.0);
+
+        Matrix<double, StorageOrder::RowMajor> mat(size, size);
+        for (size_t i = 0; i < size; ++i) {
+            mat.update(i, i, 10.0);
+            for (size_t k = 0; k < nnz_per_row; ++k) {
+                mat.update(i, col_dist(gen), val_dist(gen));
+            }
+        }
+        std::vector<double> v = getRandomVector<double>(size);
+
+        const AllocationPolicy policies[] = {AllocationPolicy::Default, AllocationPolicy::Arena,
+                                             AllocationPolicy::ArenaTransparentHugePages, AllocationPolicy::ArenaExplicitHugePages};
+        const size_t cycles = std::max<size_t>(1, repetitions / 10);
+        std::vector<double> expected;
+
+        std::cout << std::left << std::setw(34) << "Policy"
+                << std::setw(18) << "product (ms)"
+                << std::setw(18) << "cycle (ms)"
+                << std::setw(14) << "max error" << "\n";
+        std::cout << std::string(84, '-') << "\n";
+
+        for (AllocationPolicy policy : policies) {
+            mat.set_allocation_policy(policy);
+            mat.compress();
+
+            // Product
+            std::vector<double> result;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (size_t r = 0; r < repetitions; ++r) {
+                result = mat.product_by_vector(v);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            double time_product = std::chrono::duration<double, std::milli>(end - start).count() / repetitions;
+
+            // Decompress/compress cycle (arena policies reuse their block)
+            start = std::chrono::high_resolution_clock::now();
+            for (size_t r = 0; r < cycles; ++r) {
+                mat.decompress();
+                mat.compress();
+            }
+            end = std::chrono::high_resolution_clock::now();
+            double time_cycle = std::chrono::duration<double, std::milli>(end - start).count() / cycles;
+
+            if (expected.empty()) {
+                expected = result;
+            }
+            double diff = 0;
+            for (size_t i = 0; i < size; ++i) { diff = std::max(diff, std::abs(result[i] - expected[i])); }
+
+            std::cout << std::left << std::setw(34) << allocationPolicyToString(policy)
+                    << std::setw(18) << time_product
+                    << std::setw(18) << time_cycle
+                    << std::setw(14) << diff << "\n";
+            file << allocationPolicyToString(policy) << "," << time_product << "," << time_cycle << "," << diff << "\n";
+
+            mat.decompress();
+        }
+        std::cout << "\n";
+
+        // Storage actually obtained by the last policy
+        mat.compress();
+        mat.info();
+
+        std::cout << "\n=== Done. Results saved to allocation_policy.csv ===\n";
+    }
+
+    void batch_spmv_speedtest(size_t n_matrices, size_t min_rows, size_t max_rows, size_t n_large, size_t repetitions) {
+    // Compares a loop of product_by_vector() calls with the work-stealing batch executor
+    // on a batch of many small matrices and a few large ones.
+
+        std::cout << "=== Batch SpMV Speedtest ===\n\n";
+
+        using Mat = Matrix<double, StorageOrder::RowMajor>;
+        const size_t nnz_per_row = 8;
+        const size_t large_rows = 2 * params::BATCH_LARGE_JOB_NNZ / nnz_per_row;
+
+        // Random matrices, compressed
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<size_t> rows_dist(min_rows, max_rows);
+        std::uniform_real_distribution<double> val_dist(1.0, 9.0);
+
+        std::vector<Mat> matrices;
+        matrices.reserve(n_matrices + n_large);
+        for (size_t m = 0; m < n_matrices + n_large; ++m) {
+            size_t n = (m < n_matrices) ? rows_dist(gen) : large_rows;
+            std::uniform_int_distribution<size_t> col_dist(0, n - 1);
+            Mat mat(n, n);
+            for (size_t i = 0; i < n; ++i) {
+                mat.update(i, i, 10.0);
+                for (size_t k = 1; k < nnz_per_row; ++k) {
+                    mat.update(i, col_dist(gen), val_dist(gen));
+                }
+            }
+            mat.compress();
+            matrices.push_back(std::move(mat));
+        }
+        std::shuffle(matrices.begin(), matrices.end(), gen); // large jobs anywhere in the batch
+
+        // Input vectors, drawn after the shuffle so that each one matches the columns of its matrix
+        std::vector<std::vector<double>> xs;
+        xs.reserve(matrices.size());
+        for (const auto& mat : matrices) {
+            xs.push_back(getRandomVector<double>(mat.size()[1]));
+        }
+
+        // Latency percentile of a batch
+        auto percentile = [](std::vector<double> values, double p) {
+            std::sort(values.begin(), values.end());
+            size_t rank = static_cast<size_t>(std::ceil(p * values.size()));
+            return values[std::min(values.size(), std::max<size_t>(rank, 1)) - 1];
+        };
+
+        // 1. Loop of product_by_vector()
+        std::vector<std::vector<double>> expected(matrices.size());
+        std::vector<double> latency(matrices.size());
+        double loop_ms = 0, loop_p50 = 0, loop_p99 = 0;
+        for (size_t r = 0; r < repetitions; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t m = 0; m < matrices.size(); ++m) {
+                expected[m] = matrices[m].product_by_vector(xs[m]);
+                latency[m] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }
+            loop_ms += latency.back();
+            loop_p50 += percentile(latency, 0.50);
+            loop_p99 += percentile(latency, 0.99);
+        }
+        loop_ms /= repetitions;
+        loop_p50 /= repetitions;
+        loop_p99 /= repetitions;
+
+        // 2. Batch executor
+        BatchExecutor<double, StorageOrder::RowMajor> executor(omp_get_max_threads());
+        std::vector<std::vector<double>> ys(matrices.size());
+        std::vector<SpMVJob<double, StorageOrder::RowMajor>> jobs;
+        for (size_t m = 0; m < matrices.size(); ++m) {
+            jobs.push_back({&matrices[m], &xs[m], &ys[m]});
+        }
+        BatchStats total;
+        for (size_t r = 0; r < repetitions; ++r) {
+            BatchStats stats = executor.run(jobs);
+            total.elapsed_ms += stats.elapsed_ms / repetitions;
+            total.p50_latency_ms += stats.p50_latency_ms / repetitions;
+            total.p99_latency_ms += stats.p99_latency_ms / repetitions;
+            total.n_steals += stats.n_steals;
+            total.n_large_jobs = stats.n_large_jobs;
+        }
+
+        double diff = 0;
+        for (size_t m = 0; m < matrices.size(); ++m) {
+            for (size_t i = 0; i < ys[m].size(); ++i) { diff = std::max(diff, std::abs(ys[m][i] - expected[m][i])); }
+        }
+
+        std::cout << matrices.size() << " jobs (" << total.n_large_jobs << " large), "
+                << executor.n_workers() << " workers, " << total.n_steals / repetitions << " steals per batch\n\n";
+        std::cout << std::left << std::setw(26) << "Method"
+                << std::setw(16) << "batch (ms)"
+                << std::setw(16) << "jobs/s"
+                << std::setw(16) << "p50 (ms)"
+                << std::setw(16) << "p99 (ms)" << "\n";
+        std::cout << std::string(90, '-') << "\n";
+
+        std::ofstream file("output/batch_spmv.csv");
+        file << "Method,BatchTimeMs,JobsPerSecond,P50LatencyMs,P99LatencyMs\n";
+        auto report = [&](const char* method, double ms, double p50, double p99) {
+            double rate = matrices.size() / (ms / 1000.0);
+            std::cout << std::left << std::setw(26) << method << std::setw(16) << ms << std::setw(16) << rate
+                    << std::setw(16) << p50 << std::setw(16) << p99 << "\n";
+            file << method << "," << ms << "," << rate << "," << p50 << "," << p99 << "\n";
+        };
+        report("product_by_vector loop", loop_ms, loop_p50, loop_p99);
+        report("BatchExecutor", total.elapsed_ms, total.p50_latency_ms, total.p99_latency_ms);
+
+        std::cout << "\nMax error: " << diff << "\n";
+        std::cout << "\n=== Done. Results saved to batch_spmv.csv ===\n";
+    }
+
+    void expression_template_test(size_t size, size_t nnz_per_row, size_t repetitions) {
+    // Times y = A*x + B*z - alpha*w with temporaries and with the fused expression templates,
+    // for B stored in CSR and in CSC, and checks the results.
+
+        std::cout << "=== Expression Template Test ===\n\n";
+
+        // Random matrices A (CSR) and B (CSR and CSC)
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<size_t> col_dist(0, size - 1);
+        std::uniform_real_distribution<double> val_dist(1.0, 9.0);
+
+        Matrix<double, StorageOrder::RowMajor> A(size, size), B_row(size, size);
+        Matrix<double, StorageOrder::ColumnMajor> B_col(size, size);
+        for (size_t i = 0; i < size; ++i) {
+            for (size_t k = 0; k < nnz_per_row; ++k) {
+                A.update(i, col_dist(gen), val_dist(gen));
+                size_t j = col_dist(gen);
+                double value = val_dist(gen);
+                B_row.update(i, j, value);
+                B_col.update(i, j, value);
+            }
+        }
+        A.compress();
+        B_row.compress();
+        B_col.compress();
+
+        std::vector<double> x = getRandomVector<double>(size);
+        std::vector<double> z = getRandomVector<double>(size);
+        std::vector<double> w = getRandomVector<double>(size);
+        const double alpha = 0.5;
+
+        std::cout << std::left << std::setw(20) << "B storage"
+                << std::setw(20) << "temporaries (ms)"
+                << std::setw(20) << "fused (ms)"
+                << std::setw(14) << "max error" << "\n";
+        std::cout << std::string(74, '-') << "\n";
+
+        auto run = [&]<StorageOrder Order>(const Matrix<double, Order>& B) {
+            // 1. Products returning temporaries, combined by a loop
+            std::vector<double> expected(size);
+            auto start = std::chrono::high_resolution_clock::now();
+            for (size_t r = 0; r < repetitions; ++r) {
+                std::vector<double> Ax = A.product_by_vector(x);
+                std::vector<double> Bz = B.product_by_vector(z);
+                for (size_t i = 0; i < size; ++i) {
+                    expected[i] = Ax[i] + Bz[i] - alpha * w[i];
+                }
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            double time_temporaries = std::chrono::duration<double, std::milli>(end - start).count() / repetitions;
+
+            // 2. Fused expression
+            std::vector<double> y(size);
+            start = std::chrono::high_resolution_clock::now();
+            for (size_t r = 0; r < repetitions; ++r) {
+                assign(y, A*x + B*z - alpha*w);
+            }
+            end = std::chrono::high_resolution_clock::now();
+            double time_fused = std::chrono::duration<double, std::milli>(end - start).count() / repetitions;
+
+            double diff = 0;
+            for (size_t i = 0; i < size; ++i) { diff = std::max(diff, std::abs(y[i] - expected[i])); }
+
+            std::cout << std::left << std::setw(20) << storageOrderToString(Order)
+                    << std::setw(20) << time_temporaries
+                    << std::setw(20) << time_fused
+                    << std::setw(14) << diff << "\n";
+        };
+
+        run(B_row);
+        run(B_col);
+
+        // Plain assignment, and a destination that is also read by the expression
+        std::vector<double> y = A*x - w;
+        std::vector<double> expected = A.product_by_vector(x);
+        for (size_t i = 0; i < size; ++i) { expected[i] -= w[i]; }
+
+        auto check_aliased = [&](const std::string& name, const std::vector<double>& reference) {
+            double diff = 0;
+            for (size_t i = 0; i < size; ++i) { diff = std::max(diff, std::abs(y[i] - reference[i])); }
+            std::cout << "Aliased destination (" << name << ") max error: " << diff << "\n";
+        };
+        std::cout << "\n";
+
+        // 1. y = A*y (input of a matrix term)
+        std::vector<double> expected_aliased = A.product_by_vector(expected);
+        assign(y, A*y);
+        check_aliased("y = A*y", expected_aliased);
+
+        // 2. y = A*x + y (vector operand)
+        expected_aliased = A.product_by_vector(x);
+        for (size_t i = 0; i < size; ++i) { expected_aliased[i] += y[i]; }
+        assign(y, A*x + y);
+        check_aliased("y = A*x + y", expected_aliased);
+
+        // 3. y = alpha*y (scaled vector operand)
+        for (size_t i = 0; i < size; ++i) { expected_aliased[i] = alpha * y[i]; }
+        assign(y, alpha*y);
+        check_aliased("y = alpha*y", expected_aliased);
+    }
+
+    void index_compression_speedtest(const std::string& filename, size_t grid_size, size_t repetitions) {
+    // Compares weight and product time of plain and delta-encoded indices on a Matrix Market matrix
+    // and on a 2D Laplacian, checking the encoded products and the decoding.
+
+        std::cout << "=== Index Compression Speedtest ===\n\n";
+
+        std::ofstream file("output/index_compression.csv");
+        file << "Matrix,Bits,Escapes,PlainBytes,EncodedBytes,Ratio,Kernel,PlainTimeMs,EncodedTimeMs,Speedup\n";
+
+        auto run = [&](const std::string& name, const Matrix<double, StorageOrder::RowMajor>& mat) {
+            IndexCompressedMatrix<double, StorageOrder::RowMajor> enc(mat);
+            enc.info();
+
+            std::vector<double> v = getRandomVector<double>(mat.size()[1]);
+            const size_t reps = std::max<size_t>(repetitions, 50000000 / std::max<size_t>(enc.nnz(), 1));
+
+            // Correctness: encoded products and decoding
+            auto expected = mat.compressed_product_by_vector(v);
+            auto serial = enc.compressed_product_by_vector(v);
+            auto parallel = enc.compressed_product_by_vector_parallel(v);
+            auto decoded = enc.decode().compressed_product_by_vector(v);
+            double diff = 0;
+            for (size_t i = 0; i < expected.size(); ++i) {
+                diff = std::max({diff, std::abs(serial[i] - expected[i]), std::abs(parallel[i] - expected[i]), std::abs(decoded[i] - expected[i])});
+            }
+            std::cout << "Max error (products and decode): " << diff << "\n";
+
+            // Timing
+            auto time = [&](auto&& product) {
+                std::vector<double> result;
+                auto start = std::chrono::high_resolution_clock::now();
+                for (size_t r = 0; r < reps; ++r) {
+                    result = product(v);
+                }
+                auto end = std::chrono::high_resolution_clock::now();
+                return std::chrono::duration<double, std::milli>(end - start).count() / reps;
+            };
+            double plain_serial = time([&](const std::vector<double>& x) { return mat.compressed_product_by_vector(x); });
+            double enc_serial = time([&](const std::vector<double>& x) { return enc.compressed_product_by_vector(x); });
+            double plain_parallel = time([&](const std::vector<double>& x) { return mat.compressed_product_by_vector_parallel(x); });
+            double enc_parallel = time([&](const std::vector<double>& x) { return enc.compressed_product_by_vector_parallel(x); });
+
+            std::cout << std::left << std::setw(12) << "Kernel"
+                    << std::setw(18) << "plain (ms)"
+                    << std::setw(18) << "encoded (ms)"
+                    << std::setw(12) << "speedup" << "\n";
+            std::cout << std::string(60, '-') << "\n";
+            auto report = [&](const char* kernel, double plain, double encoded) {
+                std::cout << std::left << std::setw(12) << kernel << std::setw(18) << plain << std::setw(18) << encoded
+                        << std::setw(12) << plain / encoded << "\n";
+                file << name << "," << enc.index_bits() << "," << enc.n_escapes() << "," << enc.plain_weight() << ","
+                     << enc.weight() << "," << enc.compression_ratio() << "," << kernel << "," << plain << ","
+                     << encoded << "," << plain / encoded << "\n";
+            };
+            report("serial", plain_serial, enc_serial);
+            report("parallel", plain_parallel, enc_parallel);
+            std::cout << "\n";
+        };
+
+        // 1. Matrix Market matrix
+        Matrix<double, StorageOrder::RowMajor> mat(0, 0);
+        if (mat.mm_load_mtx(filename)) {
+            mat.compress();
+            std::cout << filename << "\n";
+            run(filename, mat);
+        } else {
+            std::cerr << "❌ Failed to load Matrix Market file: " << filename << "\n";
+        }
+
+        // 2. 5-point Laplacian (natural ordering: neighbours at distance 1 and grid_size)
+        const size_t n = grid_size * grid_size;
+        Matrix<double, StorageOrder::RowMajor> laplacian(n, n);
+        for (size_t r = 0; r < grid_size; ++r) {
+            for (size_t c = 0; c < grid_size; ++c) {
+                size_t i = r * grid_size + c;
+                laplacian.update(i, i, 4.0);
+                if (r > 0) laplacian.update(i, i - grid_size, -1.0);
+                if (c > 0) laplacian.update(i, i - 1, -1.0);
+                if (c + 1 < grid_size) laplacian.update(i, i + 1, -1.0);
+                if (r + 1 < grid_size) laplacian.update(i, i + grid_size, -1.0);
+            }
+        }
+        laplacian.compress();
+        std::cout << "2D Laplacian (" << grid_size << " x " << grid_size << " grid)\n";
+        run("laplacian", laplacian);
+
+        std::cout << "=== Done. Results saved to index_compression.csv ===\n";
+    }
 }
 
 #endif //TESTS_TPP
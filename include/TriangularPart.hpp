@@ -0,0 +1,19 @@
+#ifndef TRIANGULARPART_HPP
+#define TRIANGULARPART_HPP
+
+namespace algebra {
+
+/**
+ * @brief Enumeration of the triangular parts of a matrix used by the triangular solves.
+ * 
+ * - @ref TriangularPart::Lower : diagonal and entries below it.
+ * - @ref TriangularPart::Upper : diagonal and entries above it.
+ */
+enum class TriangularPart {
+    Lower, ///< Lower triangle (j <= i).
+    Upper  ///< Upper triangle (j >= i).
+};
+
+} // namespace algebra
+
+#endif // TRIANGULARPART_HPP
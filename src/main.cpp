@@ -24,8 +24,15 @@ using namespace algebra;
  * 7. Matrix Resize Test
  * 8. Diagonal View Test
  * 9. All (Rowmajor/ ColumnMajor , Compressed / Uncompressed) Multiplication Speedtest
+ * 10. Pattern Refill Test (frozen pattern + value refill)
+ * 11. Compress / Decompress Throughput Speedtest
+ * 12. Triangular Solve and Symmetric Gauss-Seidel Test
+ * 13. Allocation Policy Speed Test
+ * 14. Batch SpMV Speed Test
+ * 15. Expression Template Test
+ * 16. Index Compression Speedtest (lnsp_131.mtx + 2D Laplacian)
  * 
- * The user is prompted to select a test case by entering a number between 1 and 9.
+ * The user is prompted to select a test case by entering a number between 1 and 16.
  * 
  * @return 0 on successful execution of the selected test, or 1 if an invalid choice is entered.
  */
@@ -41,7 +48,14 @@ int main() {
     std::cout << "7. Matrix Resize Test\n";
     std::cout << "8. Diagonal View Test\n";
     std::cout << "9. All (Rowmajor/ ColumnMajor , Compressed / Uncompressed) Multiplication Speedtest\n";
-    std::cout << "Enter your choice (1-9): ";
+    std::cout << "10. Pattern Refill Test (frozen pattern + value refill)\n";
+    std::cout << "11. Compress / Decompress Throughput Speedtest\n";
+    std::cout << "12. Triangular Solve and Symmetric Gauss-Seidel Test\n";
+    std::cout << "13. Allocation Policy Speed Test\n";
+    std::cout << "14. Batch SpMV Speed Test\n";
+    std::cout << "15. Expression Template Test\n";
+    std::cout << "16. Index Compression Speedtest (lnsp_131.mtx + 2D Laplacian)\n";
+    std::cout << "Enter your choice (1-16): ";
 
     // Read user input for test selection
     int choice;
@@ -76,6 +90,27 @@ int main() {
         case 9:
             tests::multiplication_all_speedtest();
             break;
+        case 10:
+            tests::pattern_refill_test();
+            break;
+        case 11:
+            tests::conversion_throughput_speedtest();
+            break;
+        case 12:
+            tests::triangular_solve_test();
+            break;
+        case 13:
+            tests::allocation_policy_speedtest();
+            break;
+        case 14:
+            tests::batch_spmv_speedtest();
+            break;
+        case 15:
+            tests::expression_template_test();
+            break;
+        case 16:
+            tests::index_compression_speedtest();
+            break;
         default:
             // Handle invalid input
             std::cout << "Invalid choice.\n";